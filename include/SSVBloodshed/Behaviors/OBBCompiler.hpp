@@ -0,0 +1,310 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_BEHAVIORS_COMPILER
+#define SSVOB_BEHAVIORS_COMPILER
+
+#include <stdexcept>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/Behaviors/OBBehavior.hpp"
+
+namespace ob
+{
+    // Compiles a behavior definition into bytecode
+    //
+    // {
+    //     "weapons": ["ePlasmaStarGun", ["plasmaCannon", pattern]],
+    //     "sounds": ["Sounds/spark.wav"],
+    //     "tracks": [[statement, ...], ...]
+    // }
+    //
+    // Statements:
+    //     ["wait", frames]                     ["aim"]
+    //     ["turn", deg]                        ["push", accel]
+    //     ["brake", mult]                      ["smash", on]
+    //     ["charge", count, spread]            ["sound", idx]
+    //     ["summon", runnerType, dist]
+    //     ["shoot", wpn, spread, dist, posDeg, muzzleCount]
+    //     ["shootAimed", wpn, spread, dist, posDeg, muzzleCount]
+    //     ["repeat", times, [body]] - negative times repeat forever
+    //     ["if", condition, [then], [else]]
+    //     ["while", condition, [body]]
+    //
+    // Conditions:
+    //     ["distLess", x] ["distGreater", x] ["healthLess", fraction]
+    //     ["random", chance] ["aligned", deg] ["sightMelee"]
+    //     ["sightRanged"] ["armed"] ["not", condition]
+    //
+    // Weapons given with a pattern fire it instead of their own one - see
+    // `getPatternFromJson` for the pattern format
+    //
+    // Bounded repeats nest at most `OBBehavior::maxLoopDepth` deep - deeper
+    // ones throw, as the interpreter has no room for their counters
+    //
+    // Unknown statements and conditions, non-numeric arguments and weapon
+    // or sound indices out of range throw as well, so that the interpreter
+    // never has to check them
+    class OBBCompiler
+    {
+    private:
+        OBBehavior& behavior;
+        SizeT loopDepth{0};
+
+        [[noreturn]] inline static void fail(const std::string& mMsg)
+        {
+            throw std::runtime_error{"Behavior error: " + mMsg};
+        }
+
+        inline static std::string getName(const ssvj::Arr& mS)
+        {
+            if(mS.empty() || !mS[0].is<std::string>())
+                fail("statement or condition without a name");
+            return mS[0].as<std::string>();
+        }
+        inline static float getArg(const ssvj::Arr& mS, SizeT mIdx)
+        {
+            if(mIdx >= mS.size()) return 0.f;
+
+            const auto& v(mS[mIdx]);
+            if(!v.is<ssvj::IntS>() && !v.is<ssvj::IntU>() &&
+                !v.is<ssvj::Real>())
+                fail("argument " + ssvu::toStr(mIdx) + " of " + getName(mS) +
+                     " is not a number");
+            return v.as<float>();
+        }
+
+        // Index argument into a table of `mCount` entries
+        inline static std::uint8_t getIdx(
+            const ssvj::Arr& mS, SizeT mCount, const std::string& mWhat)
+        {
+            if(mS.size() < 2 ||
+                (!mS[1].is<ssvj::IntS>() && !mS[1].is<ssvj::IntU>()))
+                fail(getName(mS) + " expects a " + mWhat + " index");
+
+            auto idx(mS[1].as<long long>());
+            if(idx < 0 || SizeT(idx) >= mCount || idx > UINT8_MAX)
+                fail(mWhat + " index " + ssvu::toStr(idx) +
+                     " out of range (" + ssvu::toStr(mCount) + " " + mWhat +
+                     "s)");
+            return idx;
+        }
+        inline static const ssvj::Val& getBlock(
+            const ssvj::Arr& mS, SizeT mIdx)
+        {
+            if(mIdx >= mS.size() || !mS[mIdx].is<ssvj::Arr>())
+                fail(getName(mS) + " expects a block at argument " +
+                     ssvu::toStr(mIdx));
+            return mS[mIdx];
+        }
+
+        inline SizeT emit(OBBOp mOp, std::uint8_t mIdx = 0)
+        {
+            behavior.code.emplace_back();
+            behavior.code.back().op = mOp;
+            behavior.code.back().idx = mIdx;
+            return behavior.code.size() - 1;
+        }
+        inline SizeT emit(OBBOp mOp, const ssvj::Arr& mS, SizeT mFirstArg,
+            std::uint8_t mIdx = 0)
+        {
+            auto result(emit(mOp, mIdx));
+            auto& args(behavior.code[result].args);
+            for(auto i(0u); i < args.size(); ++i)
+                args[i] = getArg(mS, mFirstArg + i);
+            return result;
+        }
+        inline std::uint16_t getHere() const noexcept
+        {
+            return behavior.code.size();
+        }
+
+        inline void compileCondJump(const ssvj::Val& mCond, bool mNegate)
+        {
+            if(!mCond.is<ssvj::Arr>()) fail("condition is not a list");
+            const auto& c(mCond.as<ssvj::Arr>());
+            const auto& name(getName(c));
+
+            if(name == "not")
+            {
+                compileCondJump(getBlock(c, 1), !mNegate);
+                return;
+            }
+
+            static std::map<std::string, OBBCond> conds{
+                {"distLess", OBBCond::DistLess},
+                {"distGreater", OBBCond::DistGreater},
+                {"healthLess", OBBCond::HealthLess},
+                {"random", OBBCond::Random}, {"aligned", OBBCond::Aligned},
+                {"sightMelee", OBBCond::SightMelee},
+                {"sightRanged", OBBCond::SightRanged},
+                {"armed", OBBCond::Armed}};
+
+            auto itr(conds.find(name));
+            if(itr == std::end(conds)) fail("unknown condition " + name);
+
+            emit(OBBOp::JumpUnless, c, 1,
+                std::uint8_t(itr->second) | (mNegate ? obbCondNot : 0));
+        }
+
+        inline void compileBlock(const ssvj::Val& mBlock)
+        {
+            for(const auto& s : mBlock.as<ssvj::Arr>()) compileStatement(s);
+        }
+
+        inline void compileStatement(const ssvj::Val& mStatement)
+        {
+            if(!mStatement.is<ssvj::Arr>()) fail("statement is not a list");
+            const auto& s(mStatement.as<ssvj::Arr>());
+            const auto& name(getName(s));
+
+            if(name == "wait")
+                emit(OBBOp::Wait, s, 1);
+            else if(name == "aim")
+                emit(OBBOp::Aim);
+            else if(name == "turn")
+                emit(OBBOp::Turn, s, 1);
+            else if(name == "push")
+                emit(OBBOp::Push, s, 1);
+            else if(name == "brake")
+                emit(OBBOp::Brake, s, 1);
+            else if(name == "smash")
+                emit(OBBOp::Smash, s, 1);
+            else if(name == "charge")
+                emit(OBBOp::Charge, s, 1);
+            else if(name == "sound")
+                emit(OBBOp::Sound,
+                    getIdx(s, behavior.soundIds.size(), "sound"));
+            else if(name == "shoot")
+                emit(OBBOp::Shoot, s, 2,
+                    getIdx(s, behavior.wpnRefs.size(), "weapon"));
+            else if(name == "shootAimed")
+                emit(OBBOp::ShootAimed, s, 2,
+                    getIdx(s, behavior.wpnRefs.size(), "weapon"));
+            else if(name == "summon")
+            {
+                const auto& types(Impl::getEnumStrVec<RunnerType>());
+                if(s.size() < 2 || !s[1].is<std::string>())
+                    fail("summon expects a runner type");
+
+                const auto& type(s[1].as<std::string>());
+                auto itr(std::find(std::begin(types), std::end(types), type));
+                if(itr == std::end(types)) fail("unknown runner type " + type);
+                emit(OBBOp::Summon, s, 2, itr - std::begin(types));
+            }
+            else if(name == "repeat")
+                compileRepeat(int(getArg(s, 1)), getBlock(s, 2));
+            else if(name == "if")
+                compileIf(s);
+            else if(name == "while")
+            {
+                if(s.size() < 2) fail("while expects a condition");
+                compileWhile(s[1], getBlock(s, 2));
+            }
+            else
+                fail("unknown statement " + name);
+        }
+
+        inline void compileRepeat(int mTimes, const ssvj::Val& mBody)
+        {
+            if(mTimes < 0)
+            {
+                auto top(getHere());
+                compileBlock(mBody);
+                behavior.code[emit(OBBOp::Jump)].target = top;
+                return;
+            }
+
+            // `LoopNext` tests the counter after the body has run, so an
+            // empty repeat must not emit a loop at all
+            if(mTimes == 0) return;
+
+            if(loopDepth == OBBehavior::maxLoopDepth)
+                fail("loops nested deeper than " +
+                     ssvu::toStr(SizeT(OBBehavior::maxLoopDepth)));
+
+            behavior.code[emit(OBBOp::LoopPush)].args[0] = mTimes;
+            auto top(getHere());
+
+            ++loopDepth;
+            compileBlock(mBody);
+            --loopDepth;
+
+            behavior.code[emit(OBBOp::LoopNext)].target = top;
+        }
+        inline void compileIf(const ssvj::Arr& mS)
+        {
+            if(mS.size() < 2) fail("if expects a condition");
+            compileCondJump(mS[1], false);
+            auto jumpToElse(getHere() - 1);
+            compileBlock(getBlock(mS, 2));
+
+            if(mS.size() < 4)
+            {
+                behavior.code[jumpToElse].target = getHere();
+                return;
+            }
+
+            auto jumpToEnd(emit(OBBOp::Jump));
+            behavior.code[jumpToElse].target = getHere();
+            compileBlock(getBlock(mS, 3));
+            behavior.code[jumpToEnd].target = getHere();
+        }
+        inline void compileWhile(const ssvj::Val& mCond, const ssvj::Val& mBody)
+        {
+            auto top(getHere());
+            compileCondJump(mCond, false);
+            auto jumpToEnd(getHere() - 1);
+            compileBlock(mBody);
+            behavior.code[emit(OBBOp::Jump)].target = top;
+            behavior.code[jumpToEnd].target = getHere();
+        }
+
+    public:
+        inline OBBCompiler(OBBehavior& mBehavior) noexcept
+            : behavior(mBehavior)
+        {
+        }
+
+        inline void compile(const ssvj::Val& mVal)
+        {
+            for(const auto& w : mVal["weapons"].as<ssvj::Arr>())
+            {
+                behavior.wpnRefs.emplace_back();
+                auto& ref(behavior.wpnRefs.back());
+
+                if(w.is<std::string>())
+                {
+                    ref.name = w.as<std::string>();
+                    continue;
+                }
+
+                const auto& a(w.as<ssvj::Arr>());
+                ref.name = a[0].as<std::string>();
+                ref.hasPattern = true;
+                ref.pattern = getPatternFromJson(a[1]);
+            }
+            behavior.soundIds = mVal["sounds"].as<std::vector<std::string>>();
+
+            for(const auto& t : mVal["tracks"].as<ssvj::Arr>())
+            {
+                if(behavior.trackStarts.size() == OBBehavior::maxTracks)
+                    fail("more than " +
+                         ssvu::toStr(SizeT(OBBehavior::maxTracks)) + " tracks");
+
+                behavior.trackStarts.emplace_back(getHere());
+                compileBlock(t);
+                emit(OBBOp::End);
+            }
+        }
+    };
+
+    inline OBBehavior getBehaviorFromJson(const ssvj::Val& mVal)
+    {
+        OBBehavior result;
+        OBBCompiler{result}.compile(mVal);
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_BEHAVIORS_BEHAVIOR
+#define SSVOB_BEHAVIORS_BEHAVIOR
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/Weapons/OBPattern.hpp"
+
+namespace ob
+{
+    // Behavior bytecode - `reg` is the instance's angle register, `facing`
+    // the enemy's current facing angle
+    enum class OBBOp : std::uint8_t
+    {
+        Wait,       // Suspends the track for `args[0]` frames
+        Aim,        // reg = facing
+        Turn,       // reg += args[0]
+        Shoot,      // Fires weapon `idx` at facing + rnd(+-args[0])
+        ShootAimed, // Fires weapon `idx` at facing + reg + rnd(+-args[0])
+        Push,       // Accelerates by args[0] toward reg
+        Brake,      // Multiplies the velocity by args[0]
+        Smash,      // Toggles floor smashing (args[0] != 0)
+        Summon,     // Spawns a runner of type `idx` at args[0] toward reg
+        Charge,     // args[0] charge particles spread by args[1]
+        Sound,      // Plays sound `idx`
+        LoopPush,   // Pushes a loop counter of args[0] iterations
+        LoopNext,   // Jumps to `target` until the loop counter runs out
+        Jump,       // Jumps to `target`
+        JumpUnless, // Jumps to `target` unless condition `idx` holds
+        End         // Stops the track
+    };
+
+    // Conditions checked by `JumpUnless` - the high bit negates them
+    enum class OBBCond : std::uint8_t
+    {
+        DistLess,    // Target closer than args[0]
+        DistGreater, // Target farther than args[0]
+        HealthLess,  // Health fraction below args[0]
+        Random,      // Random chance of args[0]
+        Aligned,     // Facing within args[0] degrees from the target
+        SightMelee,  // Target visible, force fields block
+        SightRanged, // Target visible, bullet force fields block
+        Armed        // Enemy still holds its weapon
+    };
+    constexpr std::uint8_t obbCondNot{0x80};
+
+    struct OBBInstr
+    {
+        OBBOp op;
+        std::uint8_t idx{0};
+        std::uint16_t target{0};
+        std::array<float, 4> args{{0.f, 0.f, 0.f, 0.f}};
+    };
+
+    // Weapon referenced by a behavior, optionally overriding its pattern
+    struct OBBWpnRef
+    {
+        std::string name;
+        bool hasPattern{false};
+        OBPattern pattern;
+    };
+
+    // Compiled behavior, loaded once per enemy type and shared by all its
+    // instances - every track is an independent entry point in `code`
+    struct OBBehavior
+    {
+        static constexpr SizeT maxTracks{2};
+        static constexpr SizeT maxLoopDepth{3};
+
+        std::vector<OBBInstr> code;
+        std::vector<std::uint16_t> trackStarts;
+        std::vector<OBBWpnRef> wpnRefs;
+        std::vector<std::string> soundIds;
+
+        // Resolved from `wpnRefs` the first time the behavior runs
+        std::vector<OBWpnTypeId> wpns;
+    };
+
+    // Per-instance execution state - the only behavior data enemies own
+    struct OBBState
+    {
+        struct Track
+        {
+            std::uint16_t pc{0};
+            std::uint8_t loopDepth{0};
+            bool done{false};
+            FT wait{0.f};
+            std::array<int, OBBehavior::maxLoopDepth> loops;
+        };
+
+        std::array<Track, OBBehavior::maxTracks> tracks;
+        float reg{0.f};
+
+        inline void reset(const OBBehavior& mBehavior) noexcept
+        {
+            for(auto i(0u); i < tracks.size(); ++i)
+            {
+                tracks[i] = Track{};
+                if(i < mBehavior.trackStarts.size())
+                    tracks[i].pc = mBehavior.trackStarts[i];
+                else
+                    tracks[i].done = true;
+            }
+            reg = 0.f;
+        }
+    };
+}
+
+#endif
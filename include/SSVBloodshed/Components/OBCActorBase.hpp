@@ -6,13 +6,14 @@
 #define SSVOB_COMPONENTS_ACTORBASE
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCPhys.hpp"
 #include "SSVBloodshed/Components/OBCDraw.hpp"
 
 namespace ob
 {
-    class OBCActorND : public Component
+    class OBCActorND : public Component, public OBLevelAllocated
     {
     protected:
         OBGame& game;
@@ -7,6 +7,7 @@
 
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBGame.hpp"
+#include "SSVBloodshed/OBSteering.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 
 namespace ob
@@ -15,72 +16,98 @@ namespace ob
     {
     private:
         float maxVel{150.f};
+        float neighborRadius{1500.f}, separationMult{0.06f},
+            cohesionMult{0.005f};
+        Vec2f steeringVel;
+        float steeringMult{0.f};
+        int gridIdx{-1};
 
-        inline Vec2f getSeekForce(Vec2f mTarget, float mSlowRadius) const
-            noexcept
-        {
-            SSVU_ASSERT(mSlowRadius != 0);
-
-            mTarget -= cPhys.getPosF();
-            float distance{ssvs::getMag(mTarget)};
-            ssvs::resize(mTarget, distance <= mSlowRadius
-                                      ? maxVel * distance / mSlowRadius
-                                      : maxVel);
-            return mTarget - cPhys.getVel();
-        }
-        inline Vec2f getFleeForce(Vec2f mTarget) const noexcept
+    public:
+        inline OBCBoid(Entity& mE, OBCPhys& mCPhys) : OBCActorND{mE, mCPhys}
         {
-            mTarget = cPhys.getPosF() - mTarget;
-            ssvs::resize(mTarget, maxVel);
-            return mTarget - cPhys.getVel();
+            game.getBoidGrid().add(*this);
         }
+        inline ~OBCBoid() override { game.getBoidGrid().remove(*this); }
 
-        inline Vec2f getPursuitForce(const Vec2f& mTargetPos,
-            const Vec2f& mTargetVel, float mPredictionMult,
-            float mSlowRadius) const noexcept
+        // Separation and cohesion with the nearest boids, decided by the
+        // boid grid for the whole frame and applied on top of the owner's
+        // steering - boids created this frame join in the next one
+        inline void update(FT) override
         {
-            SSVU_ASSERT(maxVel != 0);
-
-            Vec2f distance{mTargetPos - cPhys.getPosF()};
-            float prediction{ssvs::getMag(distance) / maxVel};
-            return getSeekForce(
-                mTargetPos + mTargetVel * (prediction * mPredictionMult),
-                mSlowRadius);
+            if(gridIdx != -1)
+                body.applyAccel(game.getBoidGrid().getSteering(gridIdx));
         }
-        inline Vec2f getEvadeForce(
-            const Vec2f& mTargetPos, const Vec2f& mTargetVel) const noexcept
-        {
-            SSVU_ASSERT(maxVel != 0);
 
-            Vec2f distance{mTargetPos - cPhys.getPosF()};
-            float prediction{ssvs::getMag(distance) / maxVel};
-            return getFleeForce(mTargetPos + mTargetVel * prediction);
+        // Every steering behavior accelerates towards a desired velocity -
+        // it is kept so that the force can be recomputed against the
+        // current velocity until the next decision
+        inline void steer(const Vec2f& mDesiredVel, float mForceMult) noexcept
+        {
+            steeringVel = mDesiredVel;
+            steeringMult = mForceMult;
+            repeatSteering();
         }
 
-    public:
-        inline OBCBoid(Entity& mE, OBCPhys& mCPhys) : OBCActorND{mE, mCPhys} {}
-
         inline void seek(const Vec2f& mTargetPos, float mForceMult = 0.02f,
             float mSlowRadius = 1500.f) noexcept
         {
-            body.applyAccel(getSeekForce(mTargetPos, mSlowRadius) * mForceMult);
+            steer(OBSteering::getSeekVel(
+                      cPhys.getPosF(), mTargetPos, maxVel, mSlowRadius),
+                mForceMult);
         }
         inline void pursuit(const OBCPhys& mTarget, float mForceMult = 0.02f,
             float mPredictionMult = 1.f, float mSlowRadius = 1500.f) noexcept
         {
-            body.applyAccel(getPursuitForce(mTarget.getPosF(), mTarget.getVel(),
-                                mPredictionMult, mSlowRadius) *
-                            mForceMult);
+            steer(OBSteering::getPursuitVel(cPhys.getPosF(), mTarget.getPosF(),
+                      mTarget.getVel(), maxVel, mPredictionMult, mSlowRadius),
+                mForceMult);
+        }
+        // Steers along a flow field direction at full speed
+        inline void follow(
+            const Vec2f& mDir, float mForceMult = 0.02f) noexcept
+        {
+            steer(mDir * maxVel, mForceMult);
         }
         inline void evade(
             const OBCPhys& mTarget, float mForceMult = 0.02f) noexcept
         {
-            body.applyAccel(getEvadeForce(mTarget.getPosF(), mTarget.getVel()) *
-                            mForceMult);
+            steer(OBSteering::getEvadeVel(cPhys.getPosF(), mTarget.getPosF(),
+                      mTarget.getVel(), maxVel),
+                mForceMult);
+        }
+
+        // Keeps steering towards the last desired velocity on frames where
+        // the owner doesn't take a new decision
+        inline void repeatSteering() noexcept
+        {
+            body.applyAccel((steeringVel - cPhys.getVel()) * steeringMult);
         }
 
         inline void setMaxVel(float mValue) noexcept { maxVel = mValue; }
+        inline void setNeighborRadius(float mValue) noexcept
+        {
+            neighborRadius = mValue;
+        }
+        inline void setSeparationMult(float mValue) noexcept
+        {
+            separationMult = mValue;
+        }
+        inline void setCohesionMult(float mValue) noexcept
+        {
+            cohesionMult = mValue;
+        }
+        inline void setGridIdx(int mValue) noexcept { gridIdx = mValue; }
+
         inline float getMaxVel() const noexcept { return maxVel; }
+        inline float getNeighborRadius() const noexcept
+        {
+            return neighborRadius;
+        }
+        inline float getSeparationMult() const noexcept
+        {
+            return separationMult;
+        }
+        inline float getCohesionMult() const noexcept { return cohesionMult; }
     };
 }
 
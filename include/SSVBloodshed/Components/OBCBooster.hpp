@@ -21,6 +21,8 @@ namespace ob
         ssvs::Animation animation;
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         OBCBooster(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
             OBCIdReceiver& mCIdReceiver, Dir8 mDir, float mForceMult) noexcept
             : OBCActor{mE, mCPhys, mCDraw},
@@ -38,25 +40,26 @@ namespace ob
             body.setResolve(false);
             body.addGroups(OBGroup::GBooster);
             body.addGroupsToCheck(OBGroup::GProjectile);
+            cPhys.addHandler(*this);
+        }
+
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            if(!active) return;
+            const auto& dirVec(-ssvs::getVecFromRad(rad));
+
+            // When something touches the force field, spawn particles
+            game.createPForceField(1, toPixels(mDI.body.getPosition()));
 
-            body.onDetection += [this](const DetectionInfo& mDI)
+            if(forceMult > 0.f)
+                mDI.body.applyAccel(dirVec * 30.f * forceMult);
+            else if(ssvs::getRad(mDI.body.getVelocity()) !=
+                    ssvs::getRad(dirVec))
             {
-                if(!active) return;
-                const auto& dirVec(-ssvs::getVecFromRad(rad));
-
-                // When something touches the force field, spawn particles
-                game.createPForceField(1, toPixels(mDI.body.getPosition()));
-
-                if(forceMult > 0.f)
-                    mDI.body.applyAccel(dirVec * 30.f * forceMult);
-                else if(ssvs::getRad(mDI.body.getVelocity()) !=
-                        ssvs::getRad(dirVec))
-                {
-                    mDI.body.setVelocity(
-                        dirVec * ssvs::getMag(mDI.body.getVelocity()));
-                    mDI.body.setPosition(body.getPosition());
-                }
-            };
+                mDI.body.setVelocity(
+                    dirVec * ssvs::getMag(mDI.body.getVelocity()));
+                mDI.body.setPosition(body.getPosition());
+            }
         }
 
         inline void update(FT mFT) override
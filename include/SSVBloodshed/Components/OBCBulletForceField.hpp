@@ -20,6 +20,8 @@ namespace ob
         float rad, distortion{0}, alpha{0};
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         OBCBulletForceField(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
             OBCIdReceiver& mCIdReceiver, Dir8 mDir, bool mBlockFriendly,
             bool mBlockEnemy) noexcept : OBCActor{mE, mCPhys, mCDraw},
@@ -35,35 +37,34 @@ namespace ob
             body.setResolve(false);
             body.addGroups(OBGroup::GBulletForceField);
             body.addGroupsToCheck(OBGroup::GProjectile);
+            cPhys.addHandler(*this);
+        }
 
-            body.onDetection += [this](const DetectionInfo& mDI)
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            if(!active) return;
+
+            // When something touches the force field, spawn particles
+            game.createPForceField(1, toPixels(mDI.body.getPosition()));
+
+            distortion = 10;
+
+            auto& cProjectile(getComponentFromBody<OBCProjectile>(mDI.body));
+            const auto& targetGroup(cProjectile.getTargetGroup());
+
+            if(targetGroup == OBGroup::GKillable || // If the projectile
+                                                    // kills anything
+                (blockFriendly &&
+                    targetGroup == OBGroup::GEnemyKillable) || // Or if it
+                                                               // kills
+                                                               // enemies
+                (blockEnemy &&
+                    targetGroup ==
+                        OBGroup::GFriendlyKillable)) // Or if it kills
+                                                     // friendlies
             {
-                if(!active) return;
-
-                // When something touches the force field, spawn particles
-                game.createPForceField(1, toPixels(mDI.body.getPosition()));
-
-                distortion = 10;
-
-                auto& cProjectile(
-                    getComponentFromBody<OBCProjectile>(mDI.body));
-                const auto& targetGroup(cProjectile.getTargetGroup());
-
-                if(targetGroup == OBGroup::GKillable || // If the projectile
-                                                        // kills anything
-                    (blockFriendly &&
-                        targetGroup == OBGroup::GEnemyKillable) || // Or if it
-                                                                   // kills
-                                                                   // enemies
-                    (blockEnemy &&
-                        targetGroup ==
-                            OBGroup::GFriendlyKillable)) // Or if it kills
-                                                         // friendlies
-                {
-                    if(isRadBlocked(cProjectile.getRad()))
-                        cProjectile.destroy();
-                }
-            };
+                if(isRadBlocked(cProjectile.getRad())) cProjectile.destroy();
+            }
         }
 
         inline void update(FT mFT) override
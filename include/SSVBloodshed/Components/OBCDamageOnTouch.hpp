@@ -18,20 +18,24 @@ namespace ob
         OBGroup targetGroup;
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         OBCDamageOnTouch(Entity& mE, OBCPhys& mCPhys, float mDamage,
             OBGroup mTargetGroup) noexcept : OBCActorND{mE, mCPhys},
                                              dmg{mDamage},
                                              targetGroup{mTargetGroup}
         {
             body.addGroupsToCheck(targetGroup);
-            body.onDetection += [this](const DetectionInfo& mDI)
-            {
-                auto thisStat(getEntity().getStat());
-                if(mDI.body.hasGroup(targetGroup) &&
-                    !mDI.body.hasGroup(OBGroup::GEnvDestructible))
-                    getComponentFromBody<OBCHealth>(mDI.body).damage(
-                        thisStat, this, dmg);
-            };
+            cPhys.addHandler(*this);
+        }
+
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            auto thisStat(getEntity().getStat());
+            if(mDI.body.hasGroup(targetGroup) &&
+                !mDI.body.hasGroup(OBGroup::GEnvDestructible))
+                getComponentFromBody<OBCHealth>(mDI.body).damage(
+                    thisStat, this, dmg);
         }
 
         inline void setDamage(float mValue) noexcept { dmg = mValue; }
@@ -6,11 +6,12 @@
 #define SSVOB_COMPONENTS_DIRECTION8
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCDir8 : public Component
+    class OBCDir8 : public Component, public OBLevelAllocated
     {
     private:
         Dir8 dir{Dir8::E};
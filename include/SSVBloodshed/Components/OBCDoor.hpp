@@ -15,7 +15,7 @@ namespace ob
     class OBCDoorBase : public OBCActor
     {
     protected:
-        bool openStatus{false};
+        bool openStatus{false}, blocking{false};
 
         inline void setOpen(bool mOpen) noexcept
         {
@@ -26,6 +26,19 @@ namespace ob
             cDraw[0].setColor(colors[openStatus]);
             body.setGroups(
                 !openStatus, OBGroup::GSolidGround, OBGroup::GSolidAir);
+
+            if(blocking == !openStatus) return;
+            blocking = !openStatus;
+            if(blocking)
+            {
+                game.getFlowField().addBlocker(cPhys.getPosI());
+                game.getSightGrid().addBlocker(cPhys.getPosI());
+            }
+            else
+            {
+                game.getFlowField().removeBlocker(cPhys.getPosI());
+                game.getSightGrid().removeBlocker(cPhys.getPosI());
+            }
         }
 
     public:
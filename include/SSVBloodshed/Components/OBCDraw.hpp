@@ -6,42 +6,65 @@
 #define SSVOB_COMPONENTS_RENDER
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCDraw : public Component
+    class OBCDraw : public Component, public OBLevelAllocated
     {
     private:
+        // Almost every drawable has one or two sprites (body and gun), which
+        // are stored inline - only additional sprites go to the heap
+        static constexpr SizeT inlineCount{2};
+
+        struct Item
+        {
+            sf::Sprite sprite;
+            Vec2f offset;
+        };
+
         OBGame& game;
         Body& body;
-        std::vector<sf::Sprite> sprites;
-        std::vector<Vec2f> offsets;
+        std::array<Item, inlineCount> inlineItems;
+        std::vector<Item> extraItems;
+        SizeT itemCount{0};
         int flippedX{1}, flippedY{1};
         bool scaleWithBody{false};
         Vec2f globalOffset, globalScale{1.f, 1.f};
         sf::BlendMode blendMode{sf::BlendAlpha};
 
-    public:
-        inline OBCDraw(Entity& mE, OBGame& mGame, Body& mBody) noexcept
-            : Component{mE},
-              game(mGame),
-              body(mBody)
+        // Sprite transforms are only recomputed when the body moved or
+        // resized, or when something that affects them was changed
+        Vec2i lastPosition, lastSize;
+        bool dirty{true};
+
+        inline Item& getItem(SizeT mIdx) noexcept
         {
+            SSVU_ASSERT(mIdx < itemCount);
+            return mIdx < inlineCount ? inlineItems[mIdx]
+                                      : extraItems[mIdx - inlineCount];
+        }
+        inline const Item& getItem(SizeT mIdx) const noexcept
+        {
+            SSVU_ASSERT(mIdx < itemCount);
+            return mIdx < inlineCount ? inlineItems[mIdx]
+                                      : extraItems[mIdx - inlineCount];
         }
 
-        inline void update(FT) override
+        inline void refreshTransforms()
         {
             const auto& position(toPixels(body.getPosition()));
             const auto& size(body.getSize());
 
-            for(auto i(0u); i < sprites.size(); ++i)
+            for(auto i(0u); i < itemCount; ++i)
             {
-                auto& s(sprites[i]);
+                auto& item(getItem(i));
+                auto& s(item.sprite);
 
                 const auto& rect(s.getTextureRect());
                 s.setOrigin({rect.width / 2.f, rect.height / 2.f});
-                s.setPosition(position + globalOffset + offsets[i]);
+                s.setPosition(position + globalOffset + item.offset);
                 s.setScale(globalScale.x * flippedX, globalScale.y * flippedY);
 
                 if(scaleWithBody)
@@ -49,55 +72,95 @@ namespace ob
                         toPixels(size.y) / rect.height);
             }
         }
+
+    public:
+        inline OBCDraw(Entity& mE, OBGame& mGame, Body& mBody) noexcept
+            : Component{mE},
+              game(mGame),
+              body(mBody)
+        {
+        }
+
+        inline void update(FT) override
+        {
+            const auto& position(body.getPosition());
+            const auto& size(body.getSize());
+
+            if(!dirty && position == lastPosition && size == lastSize) return;
+
+            lastPosition = position;
+            lastSize = size;
+            dirty = false;
+            refreshTransforms();
+        }
         inline void draw() override
         {
-            for(const auto& s : sprites) game.render(s, blendMode);
+            for(auto i(0u); i < itemCount; ++i)
+                game.render(getItem(i).sprite, blendMode);
         }
 
         template <typename... TArgs>
         inline void emplaceSprite(TArgs&&... mArgs)
         {
-            sprites.emplace_back(FWD(mArgs)...);
-            offsets.emplace_back();
+            if(itemCount < inlineCount)
+                inlineItems[itemCount] = Item{sf::Sprite(FWD(mArgs)...), {}};
+            else
+                extraItems.emplace_back(Item{sf::Sprite(FWD(mArgs)...), {}});
+
+            ++itemCount;
+            dirty = true;
         }
 
         inline void rotate(float mDeg) noexcept
         {
-            for(auto& s : sprites) s.rotate(mDeg);
+            for(auto i(0u); i < itemCount; ++i) getItem(i).sprite.rotate(mDeg);
         }
 
         inline void setRotation(float mDeg) noexcept
         {
-            for(auto& s : sprites) s.setRotation(mDeg);
+            for(auto i(0u); i < itemCount; ++i)
+                getItem(i).sprite.setRotation(mDeg);
+        }
+        inline void setOffset(SizeT mIdx, const Vec2f& mOffset) noexcept
+        {
+            getItem(mIdx).offset = mOffset;
+            dirty = true;
         }
         inline void setFlippedX(bool mFlippedX) noexcept
         {
             flippedX = mFlippedX ? -1 : 1;
+            dirty = true;
         }
         inline void setFlippedY(bool mFlippedY) noexcept
         {
             flippedY = mFlippedY ? -1 : 1;
+            dirty = true;
         }
         inline void setScaleWithBody(bool mScale) noexcept
         {
             scaleWithBody = mScale;
+            dirty = true;
         }
         inline void setGlobalOffset(const Vec2f& mOffset) noexcept
         {
             globalOffset = mOffset;
+            dirty = true;
         }
         inline void setGlobalScale(float mFactor) noexcept
         {
             globalScale.x = globalScale.y = mFactor;
+            dirty = true;
         }
         inline void setGlobalScale(float mX, float mY) noexcept
         {
             globalScale.x = mX;
             globalScale.y = mY;
+            dirty = true;
         }
         inline void setGlobalScale(const Vec2f& mScale) noexcept
         {
             globalScale = mScale;
+            dirty = true;
         }
         inline void setBlendMode(sf::BlendMode mMode) noexcept
         {
@@ -105,23 +168,21 @@ namespace ob
         }
 
         inline OBGame& getGame() const noexcept { return game; }
-        inline const decltype(sprites)& getSprites() const noexcept
-        {
-            return sprites;
-        }
-        inline const decltype(offsets)& getOffsets() const noexcept
+        inline SizeT getSpriteCount() const noexcept { return itemCount; }
+        inline const Vec2f& getOffset(SizeT mIdx) const noexcept
         {
-            return offsets;
+            return getItem(mIdx).offset;
         }
-        inline decltype(sprites)& getSprites() noexcept { return sprites; }
-        inline decltype(offsets)& getOffsets() noexcept { return offsets; }
+
+        // Mutable access may change texture rects
         inline sf::Sprite& operator[](unsigned int mIdx)
         {
-            return sprites[mIdx];
+            dirty = true;
+            return getItem(mIdx).sprite;
         }
         inline const sf::Sprite& operator[](unsigned int mIdx) const
         {
-            return sprites[mIdx];
+            return getItem(mIdx).sprite;
         }
         inline bool isFlippedX() const noexcept { return flippedX == -1; }
         inline bool isFlippedY() const noexcept { return flippedY == -1; }
@@ -25,6 +25,9 @@ namespace ob
         bool faceDirection{true}, bounced{false};
 
     public:
+        static constexpr int physEvents{
+            OBPhysEvent::Resolution | OBPhysEvent::PreUpdate};
+
         OBCEnemy(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
             OBCKillable& mCKillable, OBCTargeter& mCTargeter,
             OBCBoid& mCBoid) noexcept : OBCActor{mE, mCPhys, mCDraw},
@@ -42,26 +45,24 @@ namespace ob
             body.addGroupsToCheck(OBGroup::GSolidGround, OBGroup::GLevelBound);
             body.setRestitutionX(1.f);
             body.setRestitutionY(1.f);
-
-            body.onPreUpdate += [this]
-            {
-                constexpr float maxVel{800.f};
-                cPhys.setVel(ssvs::getMClamped(
-                    cPhys.getVel(), bounced ? minBounceVel : 0.f, maxVel));
-                bounced = false;
-            };
-            body.onResolution += [this](const ResolutionInfo&)
-            {
-                bounced = true;
-            };
+            cPhys.addHandler(*this);
 
             cKillable.onDeath += [this]
             {
-                game.createEShard(1 + cKillable.getCHealth().getMaxHealth() / 3,
-                    cPhys.getPosI());
+                game.getCommands().spawnShards(cPhys.getPosI(),
+                    1 + cKillable.getCHealth().getMaxHealth() / 3);
             };
         }
 
+        inline void handlePreUpdate()
+        {
+            constexpr float maxVel{800.f};
+            cPhys.setVel(ssvs::getMClamped(
+                cPhys.getVel(), bounced ? minBounceVel : 0.f, maxVel));
+            bounced = false;
+        }
+        inline void handleResolution(const ResolutionInfo&) { bounced = true; }
+
         inline void update(FT mFT) override
         {
             snappedDeg = ob::getSnappedDeg(currentDeg);
@@ -8,7 +8,6 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCHealth.hpp"
-#include "SSVBloodshed/Components/OBCFloor.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 #include "SSVBloodshed/Components/OBCEnemy.hpp"
 #include "SSVBloodshed/Components/OBCForceField.hpp"
@@ -20,83 +19,224 @@
 #include "SSVBloodshed/Components/OBCWpnController.hpp"
 #include "SSVBloodshed/Components/OBCTurret.hpp"
 #include "SSVBloodshed/Weapons/OBWpnTypes.hpp"
+#include "SSVBloodshed/Behaviors/OBBehavior.hpp"
 
 namespace ob
 {
-    inline bool raycastToPlayer(OBCPhys& mSeeker, OBCPhys& mTarget,
-        bool mCheckBulletForceField, bool mCheckForceField)
+    class OBCEBase : public OBCActor
     {
-        const auto& startPos(mSeeker.getPosI());
-        Vec2f dir(mTarget.getPosI() - startPos);
-        // direction =
-        // Vec2f(getVecFromDir8(getDir8FromDeg(ssvs::getDeg(direction))));
+        friend class OBGAIScheduler;
+
+    protected:
+        using Mind = OBGAIScheduler::Mind;
+
+        OBCEnemy& cEnemy;
+        OBCKillable& cKillable;
+        OBCBoid& cBoid;
+        OBCTargeter& cTargeter;
+        OBCHealth& cHealth;
+
+        // Decisions (steering and whether to shoot) are taken and
+        // time-sliced by the game's AI scheduler - weapons and behaviors
+        // still run every frame on the last decision
+        Mind mind{Mind::None};
+        float evadeDist{0.f};
+        OBGAIScheduler::Decision decision;
+        FT thinkTimer, thinkElapsed{0.f};
+        int aiIdx{-1};
+        SizeT memberIdx;
+
+        // Applies the scheduler's decision if this enemy thought this frame,
+        // and keeps steering by the last one otherwise
+        inline bool think()
+        {
+            const auto& scheduler(game.getAIScheduler());
+            if(aiIdx == -1 || !scheduler.isThinking(aiIdx))
+            {
+                cBoid.repeatSteering();
+                return false;
+            }
 
-        auto gridQuery(mSeeker.getWorld().getQuery<ssvsc::QueryType::RayCast>(
-            startPos, ssvs::getNormalized(dir)));
+            decision = scheduler.getDecision(aiIdx);
+            thinkTimer = OBGAIScheduler::getThinkDelay(
+                decision.dist, decision.inSightRanged);
+            cBoid.steer(decision.steeringVel, decision.steeringMult);
+            return true;
+        }
 
-        Body* body;
-        while((body = gridQuery.next()) != nullptr)
+        inline bool checkBehaviorCond(const OBBInstr& mI)
         {
-            // If the detected body is the seeker or a friend of the seeker,
-            // continue
-            if(body == &mSeeker.getBody() || body->hasGroup(OBGroup::GEnemy))
-                continue;
-
-            // If the detected body is a bullet force field, check if the angle
-            // is
-            // valid
-            if(mCheckBulletForceField &&
-                body->hasGroup(OBGroup::GBulletForceField))
+            bool result{false};
+            const auto& arg(mI.args[0]);
+
+            switch(OBBCond(mI.idx & ~obbCondNot))
             {
-                auto& cBulletForceField(
-                    getComponentFromBody<OBCBulletForceField>(*body));
-                if(cBulletForceField.isRadBlocked(ssvs::getRad(dir)))
-                    return false;
+                case OBBCond::DistLess:
+                    result = cTargeter.getDist() < arg;
+                    break;
+                case OBBCond::DistGreater:
+                    result = cTargeter.getDist() > arg;
+                    break;
+                case OBBCond::HealthLess:
+                    result = float(cHealth.getHealth()) /
+                                 cHealth.getMaxHealth() <
+                             arg;
+                    break;
+                case OBBCond::Random:
+                    result = ssvu::getRndR(0.f, 1.f) < arg;
+                    break;
+                case OBBCond::Aligned:
+                    result = cEnemy.getDegDiff() < arg;
+                    break;
+                case OBBCond::SightMelee:
+                    result = isPlayerInSightMelee();
+                    break;
+                case OBBCond::SightRanged:
+                    result = isPlayerInSightRanged();
+                    break;
+                case OBBCond::Armed: result = isArmed(); break;
             }
 
-            // If the detected body is a force field, check if the angle is
-            // valid
-            if(mCheckForceField && body->hasGroup(OBGroup::GForceField))
+            return (mI.idx & obbCondNot) != 0 ? !result : result;
+        }
+        // Weapons given with a pattern are registered as new types firing
+        // it - this happens once per behavior, not per instance
+        inline static void resolveBehaviorWpns(OBBehavior& mBehavior)
+        {
+            auto& registry(OBWpnTypes::getRegistry());
+            for(const auto& r : mBehavior.wpnRefs)
             {
-                auto& cForceField(getComponentFromBody<OBCForceField>(*body));
-                if(cForceField.isRadBlocked(ssvs::getRad(dir))) return false;
+                auto id(registry.getId(r.name));
+                if(id != OBWpnRegistry::nullId && r.hasPattern)
+                {
+                    auto wpnType(registry[id]);
+                    wpnType.setPattern(r.pattern);
+                    id = registry.add(ssvu::mv(wpnType));
+                }
+                mBehavior.wpns.emplace_back(id);
             }
+        }
+        inline void shootBehaviorWpn(
+            OBBehavior& mBehavior, const OBBInstr& mI, float mDeg)
+        {
+            auto wpn(mBehavior.wpns[mI.idx]);
+            if(wpn == OBWpnRegistry::nullId) return;
+
+            const auto& facing(cEnemy.getCurrentDeg());
+            Vec2i shootPos{
+                body.getPosition() +
+                Vec2i(ssvs::getVecFromDeg<float>(facing + mI.args[2]) *
+                      mI.args[1])};
 
-            // If the detected body is a target, return true
-            if(body->hasGroup(OBGroup::GFriendly)) return true;
+            auto deg(facing + mDeg);
+            if(mI.args[0] != 0.f)
+                deg += ssvu::getRndR(-mI.args[0], mI.args[0]);
 
-            // If the detected body is an obstacle, return false
-            if(body->hasGroup(OBGroup::GSolidAir)) return false;
+            OBWpnTypes::getRegistry()[wpn].shoot(game, this,
+                OBGroup::GFriendlyKillable, shootPos, deg, toPixels(shootPos));
+            if(mI.args[3] > 0.f)
+                game.createPMuzzleBullet(mI.args[3], toPixels(shootPos));
         }
+        inline void runBehaviorTrack(
+            OBBehavior& mBehavior, OBBState& mState, OBBState::Track& mTrack)
+        {
+            // Bounds the work of tracks that loop without waiting
+            constexpr int maxSteps{256};
 
-        return false;
-    }
+            for(int steps{0}; mTrack.wait <= 0.f && steps < maxSteps; ++steps)
+            {
+                const auto& i(mBehavior.code[mTrack.pc++]);
+                const auto& arg(i.args[0]);
 
-    class OBCEBase : public OBCActor
-    {
-    protected:
-        OBCEnemy& cEnemy;
-        OBCKillable& cKillable;
-        OBCBoid& cBoid;
-        OBCTargeter& cTargeter;
-        OBCHealth& cHealth;
+                switch(i.op)
+                {
+                    case OBBOp::Wait: mTrack.wait += arg; break;
+                    case OBBOp::Aim: mState.reg = cEnemy.getCurrentDeg(); break;
+                    case OBBOp::Turn: mState.reg += arg; break;
+                    case OBBOp::Shoot:
+                        shootBehaviorWpn(mBehavior, i, 0.f);
+                        break;
+                    case OBBOp::ShootAimed:
+                        shootBehaviorWpn(mBehavior, i, mState.reg);
+                        break;
+                    case OBBOp::Push:
+                        body.applyAccel(ssvs::getVecFromDeg(mState.reg, arg));
+                        break;
+                    case OBBOp::Brake:
+                        body.setVelocity(cPhys.getVel() * arg);
+                        break;
+                    case OBBOp::Smash: setSmashing(arg != 0.f); break;
+                    case OBBOp::Summon:
+                        factory.createERunner(
+                            body.getPosition() +
+                                Vec2i(ssvs::getVecFromDeg<float>(mState.reg) *
+                                      arg),
+                            RunnerType(i.idx));
+                        break;
+                    case OBBOp::Charge:
+                        game.createPCharge(arg, cPhys.getPosPx(), i.args[1]);
+                        break;
+                    case OBBOp::Sound:
+                        assets.playSound(mBehavior.soundIds[i.idx]);
+                        break;
+                    case OBBOp::LoopPush:
+                        mTrack.loops[mTrack.loopDepth++] = arg;
+                        break;
+                    case OBBOp::LoopNext:
+                        if(--mTrack.loops[mTrack.loopDepth - 1] > 0)
+                            mTrack.pc = i.target;
+                        else
+                            --mTrack.loopDepth;
+                        break;
+                    case OBBOp::Jump: mTrack.pc = i.target; break;
+                    case OBBOp::JumpUnless:
+                        if(!checkBehaviorCond(i)) mTrack.pc = i.target;
+                        break;
+                    case OBBOp::End: mTrack.done = true; return;
+                }
+            }
+        }
+
+        // Advances every track of a shared behavior program by `mFT`
+        inline void runBehavior(
+            OBBehavior& mBehavior, OBBState& mState, FT mFT)
+        {
+            if(mBehavior.wpns.size() != mBehavior.wpnRefs.size())
+                resolveBehaviorWpns(mBehavior);
+
+            for(auto i(0u); i < mBehavior.trackStarts.size(); ++i)
+            {
+                auto& track(mState.tracks[i]);
+                if(track.done) continue;
+
+                track.wait -= mFT;
+                runBehaviorTrack(mBehavior, mState, track);
+            }
+        }
+
+        inline virtual bool isArmed() const noexcept { return false; }
+        inline virtual void setSmashing(bool) noexcept {}
 
     public:
         OBCEBase(Entity& mE, OBCEnemy& mCEnemy)
             : OBCActor{mE, mCEnemy.getCPhys(), mCEnemy.getCDraw()},
               cEnemy(mCEnemy), cKillable(cEnemy.getCKillable()),
               cBoid(cEnemy.getCBoid()), cTargeter(cEnemy.getCTargeter()),
-              cHealth(mCEnemy.getCKillable().getCHealth())
+              cHealth(mCEnemy.getCKillable().getCHealth()),
+              thinkTimer(ssvu::getRndI(0, 4))
         {
+            game.getAIScheduler().add(*this);
         }
+        inline ~OBCEBase() override { game.getAIScheduler().remove(*this); }
 
+        // Sight as of the last decision
         inline bool isPlayerInSightRanged() const noexcept
         {
-            return raycastToPlayer(cPhys, cTargeter.getTarget(), true, false);
+            return decision.inSightRanged;
         }
         inline bool isPlayerInSightMelee() const noexcept
         {
-            return raycastToPlayer(cPhys, cTargeter.getTarget(), false, true);
+            return decision.inSightMelee;
         }
     };
 
@@ -121,20 +261,14 @@ namespace ob
                 if(armed && wpnHealth-- <= 0)
                 {
                     armed = false;
+                    cWielder.setShooting(false);
                     game.createPElectric(10, toPixels(cPhys.getPosF()));
                 }
             };
         }
 
-        inline void pursuitOrAlign(float mDist, float mPursuitDist)
-        {
-            if(mDist > mPursuitDist)
-                cBoid.pursuit(cTargeter.getTarget());
-            else
-                cBoid.seek(ssvs::getOrbitDeg(cTargeter.getPosF(),
-                               cDir8.getDeg() + 180, mPursuitDist),
-                    0.02f, 750.f);
-        }
+        inline bool isArmed() const noexcept override { return armed; }
+
         inline void recalculateTile()
         {
             if(!armed)
@@ -163,12 +297,13 @@ namespace ob
               type{mType}
         {
             cPhys.setMass(1.f);
-            cWpnController.setWpn(OBWpnTypes::createEPlasmaBulletGun());
+            cWpnController.setWpn(WEPlasmaBulletGun);
             cEnemy.setMinBounceVel(125.f);
             cEnemy.setMaxVel(200.f);
             cKillable.setType(OBCKillable::Type::Organic);
             cWielder.setHoldDist(2.f);
             cWielder.setWieldDist(8.f);
+            mind = Mind::Gunner;
         }
         inline void update(FT) override
         {
@@ -180,16 +315,8 @@ namespace ob
                 return;
             }
 
-            cWielder.setShooting(
-                armed && cEnemy.getDegDiff() < 50.f && isPlayerInSightRanged());
-
-            if(cWielder.isShooting())
-            {
-                pursuitOrAlign(cTargeter.getDist(), 9000.f);
-                shootGun();
-            }
-            else
-                cBoid.pursuit(cTargeter.getTarget());
+            if(think()) cWielder.setShooting(decision.shooting);
+            if(cWielder.isShooting()) shootGun();
         }
     };
 
@@ -197,11 +324,14 @@ namespace ob
     {
     private:
         OBCFloorSmasher& cFloorSmasher;
-        Ticker tckCharge{250.f};
-        ssvu::Timeline tlCharge{false};
-        float lastDeg{0};
+        OBBState bState;
         ChargerType type;
 
+        inline void setSmashing(bool mValue) noexcept override
+        {
+            cFloorSmasher.setActive(mValue);
+        }
+
     public:
         OBCECharger(Entity& mE, OBCEnemy& mCEnemy,
             OBCFloorSmasher& mCFloorSmasher, OBCWielder& mCWielder,
@@ -212,10 +342,10 @@ namespace ob
         {
             cPhys.setMass(100.f);
 
-            cWpnController.setWpn(OBWpnTypes::createEPlasmaBulletGun(1, 8.f));
+            cWpnController.setWpn(WEPlasmaBulletGunFan1);
             if(type == ChargerType::GrenadeLauncher)
             {
-                cWpnController.setWpn(OBWpnTypes::createGrenadeLauncher());
+                cWpnController.setWpn(WGrenadeLauncher);
                 cDraw[1].setTextureRect(assets.e2GunGL);
             }
 
@@ -226,38 +356,8 @@ namespace ob
             cKillable.setType(OBCKillable::Type::Organic);
             cKillable.setParticleMult(2);
 
-            tlCharge.append<ssvu::WaitUntil>([this]
-                {
-                    return !armed;
-                });
-            repeat(tlCharge,
-                [this]
-                {
-                    body.setVelocity(cPhys.getVel() * 0.8f);
-                    game.createPCharge(4, cPhys.getPosPx(), 45);
-                },
-                10, 2.5f);
-            tlCharge.append<ssvu::WaitUntil>([this]
-                {
-                    game.createPCharge(1, cPhys.getPosPx(), 45);
-                    return isPlayerInSightMelee();
-                });
-            tlCharge.append<ssvu::Do>([this]
-                {
-                    cFloorSmasher.setActive(true);
-                    lastDeg = cEnemy.getCurrentDeg();
-                    body.applyAccel(ssvs::getVecFromDeg(lastDeg, 1250.f));
-                });
-            tlCharge.append<ssvu::Wait>(10.f);
-            tlCharge.append<ssvu::Do>([this]
-                {
-                    body.applyAccel(ssvs::getVecFromDeg(lastDeg, -150.f));
-                });
-            tlCharge.append<ssvu::Wait>(9.f);
-            tlCharge.append<ssvu::Do>([this]
-                {
-                    cFloorSmasher.setActive(false);
-                });
+            bState.reset(assets.bhCharger);
+            mind = Mind::Gunner;
         }
         inline void update(FT mFT) override
         {
@@ -269,35 +369,18 @@ namespace ob
                 return;
             }
 
-            cWielder.setShooting(
-                armed && cEnemy.getDegDiff() < 50.f && isPlayerInSightRanged());
-
+            if(think()) cWielder.setShooting(decision.shooting);
             if(cWielder.isShooting())
-            {
-                pursuitOrAlign(cTargeter.getDist(), 9000.f);
                 shootGun();
-            }
             else
-            {
-                cBoid.pursuit(cTargeter.getTarget());
-                tlCharge.update(mFT);
-                if(tckCharge.update(mFT))
-                {
-                    tlCharge.reset();
-                    tlCharge.start();
-                }
-            }
+                runBehavior(assets.bhCharger, bState, mFT);
         }
     };
 
     class OBCEJuggernaut : public OBCEArmedBase
     {
     private:
-        Ticker tckShoot{150.f};
-        ssvu::Timeline tlShoot{false};
-        float lastDeg{0};
-        OBWpn wpn{game, OBGroup::GFriendlyKillable,
-            OBWpnTypes::createEPlasmaStarGun(0)};
+        OBBState bState;
         JuggernautType type;
 
     public:
@@ -309,10 +392,10 @@ namespace ob
         {
             cPhys.setMass(10000.f);
 
-            cWpnController.setWpn(OBWpnTypes::createEPlasmaBulletGun(2, 8.f));
+            cWpnController.setWpn(WEPlasmaBulletGunFan2);
             if(type == JuggernautType::RocketLauncher)
             {
-                cWpnController.setWpn(OBWpnTypes::createRocketLauncher());
+                cWpnController.setWpn(WRocketLauncher);
                 cDraw[1].setTextureRect(assets.e3GunRL);
             }
 
@@ -328,35 +411,11 @@ namespace ob
             cWielder.setWieldDist(22.f);
             cWielder.setHoldDist(6.f);
 
-            repeat(tlShoot,
-                [this]
-                {
-                    shootUnarmed(ssvu::getRndI(-10, 10));
-                },
-                8, 1.1f);
-            repeat(tlShoot,
-                [this]
-                {
-                    game.createPCharge(4, cPhys.getPosPx(), 55);
-                },
-                15, 1.f);
-            tlShoot.append<ssvu::Do>([this]
-                {
-                    lastDeg = cEnemy.getCurrentDeg();
-                });
-            repeat(tlShoot,
-                [this]
-                {
-                    shootUnarmed(lastDeg);
-                    lastDeg += 265;
-                },
-                45, 0.3f);
+            bState.reset(assets.bhJuggernaut);
+            mind = Mind::Slammer;
         }
         inline void update(FT mFT) override
         {
-            constexpr float distBodySlam{2750.f};
-            constexpr float distEvade{10000.f};
-
             recalculateTile();
 
             if(!cTargeter.hasTarget())
@@ -365,39 +424,11 @@ namespace ob
                 return;
             }
 
-            const auto& dist(cTargeter.getDist());
-            cWielder.setShooting(armed && cEnemy.getDegDiff() < 50.f &&
-                                 isPlayerInSightRanged() &&
-                                 dist > distBodySlam);
-
+            if(think()) cWielder.setShooting(decision.shooting);
             if(cWielder.isShooting())
-            {
-                if(dist < distBodySlam) cBoid.pursuit(cTargeter.getTarget());
-                pursuitOrAlign(dist, distEvade - 1000.f);
                 shootGun();
-            }
             else if(!armed)
-            {
-                if(dist > distEvade || dist < distBodySlam)
-                    cBoid.pursuit(cTargeter.getTarget());
-                else
-                    cBoid.evade(cTargeter.getTarget());
-
-                tlShoot.update(mFT);
-                if(tckShoot.update(mFT))
-                {
-                    tlShoot.reset();
-                    tlShoot.start();
-                }
-            }
-        }
-
-        inline void shootUnarmed(int mDeg)
-        {
-            assets.playSound("Sounds/spark.wav");
-            game.createPMuzzleBullet(20, cPhys.getPosPx());
-            wpn.shoot(this, cPhys.getPosI(), cEnemy.getCurrentDeg() + mDeg,
-                cPhys.getPosPx());
+                runBehavior(assets.bhJuggernaut, bState, mFT);
         }
     };
 
@@ -408,6 +439,8 @@ namespace ob
         bool small{false};
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Resolution};
+
         OBCEBall(Entity& mE, OBCEnemy& mCEnemy, BallType mType, bool mSmall)
             : OBCEBase{mE, mCEnemy}, type{mType}, small{mSmall}
         {
@@ -418,12 +451,10 @@ namespace ob
                 {
                     constexpr int splitCount{3};
                     for(int i{0}; i < splitCount; ++i)
-                    {
-                        auto& e(
-                            factory.createEBall(cPhys.getPosI(), type, true));
-                        e.getComponent<OBCPhys>().setVel(ssvs::getVecFromRad(
-                            (ssvu::tau / splitCount) * i, 400.f));
-                    }
+                        game.getCommands().spawnEBall(cPhys.getPosI(),
+                            ssvs::getVecFromRad(
+                                (ssvu::tau / splitCount) * i, 400.f),
+                            type);
                 };
             }
             else
@@ -437,15 +468,18 @@ namespace ob
             if(type == BallType::Flying)
             {
                 body.addGroups(OBGroup::GFlying);
-                body.onResolution += [this](const ResolutionInfo& mRI)
-                {
-                    if(mRI.body.hasGroup(OBGroup::GSolidGround) &&
-                        !mRI.body.hasGroup(OBGroup::GSolidAir))
-                        mRI.noResolvePosition = mRI.noResolveVelocity = true;
-                };
                 body.addGroupsToCheck(OBGroup::GSolidAir);
+                cPhys.addHandler(*this);
             }
         }
+
+        // Flying balls pass over pits and other ground-only obstacles
+        inline void handleResolution(const ResolutionInfo& mRI)
+        {
+            if(mRI.body.hasGroup(OBGroup::GSolidGround) &&
+                !mRI.body.hasGroup(OBGroup::GSolidAir))
+                mRI.noResolvePosition = mRI.noResolveVelocity = true;
+        }
         inline void update(FT mFT) override
         {
             if(type == BallType::Flying && !small && ssvu::getRndI(0, 9) > 7)
@@ -458,13 +492,7 @@ namespace ob
     class OBCEGiant : public OBCEBase
     {
     private:
-        Ticker tckShoot{250.f};
-        ssvu::Timeline tlShoot{false}, tlSummon{false}, tlCannon{true};
-        OBWpn wpn{game, OBGroup::GFriendlyKillable,
-            OBWpnTypes::createEPlasmaStarGun()};
-        OBWpn wpnC{
-            game, OBGroup::GFriendlyKillable, OBWpnTypes::createPlasmaCannon()};
-        float lastDeg{0};
+        OBBState bState;
 
     public:
         OBCEGiant(Entity& mE, OBCEnemy& mCEnemy) : OBCEBase{mE, mCEnemy}
@@ -478,119 +506,23 @@ namespace ob
             cEnemy.setMinBounceVel(10.f);
             cEnemy.setMaxVel(75.f);
 
-            repeat(tlCannon,
-                [this]
-                {
-                    shootCannon(0);
-                },
-                -1, 100.f);
-
-            repeat(tlShoot,
-                [this]
-                {
-                    shoot(ssvu::getRndI(-15, 15));
-                },
-                20, 0.4f);
-            repeat(tlShoot,
-                [this]
-                {
-                    game.createPCharge(5, cPhys.getPosPx(), 65);
-                },
-                19, 1.f);
-            tlShoot.append<ssvu::Do>([this]
-                {
-                    lastDeg = cEnemy.getCurrentDeg();
-                });
-            repeat(tlShoot,
-                [this]
-                {
-                    shoot(lastDeg);
-                    lastDeg += 235;
-                },
-                150, 0.1f);
-
-            tlSummon.append<ssvu::Do>([this]
-                {
-                    lastDeg = cEnemy.getCurrentDeg();
-                });
-            repeat(tlSummon,
-                [this]
-                {
-                    game.createPCharge(5, cPhys.getPosPx(), 65);
-                    body.setVelocity(body.getVelocity() * 0.8f);
-                    factory.createERunner(
-                        body.getPosition() +
-                            Vec2i(ssvs::getVecFromDeg<float>(lastDeg) * 1500.f),
-                        RunnerType::PlasmaBolter);
-                    lastDeg += 360 / 6;
-                },
-                6, 4.5f);
-            tlSummon.append<ssvu::Wait>(19.f);
+            bState.reset(assets.bhGiant);
+            mind = Mind::Kiter;
+            evadeDist = 10000.f;
         }
         inline void update(FT mFT) override
         {
             if(!cTargeter.hasTarget()) return;
 
-            if(ssvs::getDistEuclidean(cTargeter.getPosF(), cPhys.getPosF()) >
-                10000)
-                cBoid.pursuit(cTargeter.getTarget());
-            else
-                cBoid.evade(cTargeter.getTarget());
-
-            tlCannon.update(mFT);
-            tlShoot.update(mFT);
-            tlSummon.update(mFT);
-            if(tckShoot.update(mFT))
-            {
-                if(ssvu::getRndI(0, 2) > 0)
-                {
-                    tlShoot.reset();
-                    tlShoot.start();
-                }
-                else
-                {
-                    tlSummon.reset();
-                    tlSummon.start();
-                }
-            }
-        }
-        inline void shoot(int mDeg)
-        {
-            assets.playSound("Sounds/spark.wav");
-            Vec2i shootPos{
-                body.getPosition() +
-                Vec2i(ssvs::getVecFromDeg<float>(cEnemy.getCurrentDeg()) *
-                      100.f)};
-            wpn.shoot(this, shootPos, cEnemy.getCurrentDeg() + mDeg,
-                toPixels(shootPos));
-            game.createPMuzzleBullet(20, cPhys.getPosPx());
-        }
-        inline void shootCannon(int mDeg)
-        {
-            assets.playSound("Sounds/spark.wav");
-            Vec2i shootPos1{
-                body.getPosition() +
-                Vec2i(ssvs::getVecFromDeg<float>(cEnemy.getSnappedDeg() + 40) *
-                      1400.f)};
-            Vec2i shootPos2{
-                body.getPosition() +
-                Vec2i(ssvs::getVecFromDeg<float>(cEnemy.getSnappedDeg() - 40) *
-                      1400.f)};
-            wpnC.shoot(this, shootPos1, cEnemy.getCurrentDeg() + mDeg,
-                toPixels(shootPos1));
-            wpnC.shoot(this, shootPos2, cEnemy.getCurrentDeg() + mDeg,
-                toPixels(shootPos1));
-            game.createPMuzzleBullet(35, toPixels(shootPos1));
-            game.createPMuzzleBullet(35, toPixels(shootPos2));
+            think();
+            runBehavior(assets.bhGiant, bState, mFT);
         }
     };
 
     class OBCEEnforcer : public OBCEBase
     {
     private:
-        Ticker tckShoot{100.f};
-        OBWpn wpn{
-            game, OBGroup::GFriendlyKillable, OBWpnTypes::createPlasmaCannon()};
+        OBBState bState;
 
     public:
         OBCEEnforcer(Entity& mE, OBCEnemy& mCEnemy) : OBCEBase{mE, mCEnemy}
@@ -599,33 +531,17 @@ namespace ob
             cKillable.setParticleMult(3);
             cEnemy.setMinBounceVel(45.f);
             cEnemy.setMaxVel(115.f);
-            tckShoot.setLoop(false);
+
+            bState.reset(assets.bhEnforcer);
+            mind = Mind::Kiter;
+            evadeDist = 9000.f;
         }
         inline void update(FT mFT) override
         {
             if(!cTargeter.hasTarget()) return;
 
-            tckShoot.update(mFT);
-            if(cTargeter.getDist() > 9000.f)
-                cBoid.pursuit(cTargeter.getTarget());
-            else
-                cBoid.evade(cTargeter.getTarget());
-            if(isPlayerInSightRanged() && cEnemy.getDegDiff() < 50.f)
-                shootCannon(0);
-        }
-        inline void shootCannon(int mDeg)
-        {
-            if(tckShoot.isRunning()) return;
-            tckShoot.restart(100.f);
-
-            assets.playSound("Sounds/spark.wav");
-            Vec2i shootPos{
-                body.getPosition() +
-                Vec2i(ssvs::getVecFromDeg<float>(cEnemy.getSnappedDeg() - 40) *
-                      700.f)};
-            wpn.shoot(this, shootPos, cEnemy.getCurrentDeg() + mDeg,
-                toPixels(shootPos));
-            game.createPMuzzleBullet(35, toPixels(shootPos));
+            think();
+            runBehavior(assets.bhEnforcer, bState, mFT);
         }
     };
 }
@@ -6,12 +6,13 @@
 #define SSVOB_COMPONENTS_FLOORSMASHER
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCPhys.hpp"
 
 namespace ob
 {
-    class OBCFloorSmasher : public Component
+    class OBCFloorSmasher : public Component, public OBLevelAllocated
     {
     private:
         OBCPhys& cPhys;
@@ -19,6 +20,8 @@ namespace ob
         bool active{false};
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         OBCFloorSmasher(Entity& mE, OBCPhys& mCPhys,
             bool mActive = false) noexcept : Component{mE},
                                              cPhys(mCPhys),
@@ -27,12 +30,14 @@ namespace ob
         {
             setActive(active);
             body.addGroupsNoResolve(OBGroup::GFloor);
-            body.onDetection += [this](const DetectionInfo& mDI)
-            {
-                if(active && mDI.body.hasGroup(OBGroup::GFloor) &&
-                    ssvu::getRndI(0, 10) > 8)
-                    getComponentFromBody<OBCFloor>(mDI.body).smash();
-            };
+            cPhys.addHandler(*this);
+        }
+
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            if(active && mDI.body.hasGroup(OBGroup::GFloor) &&
+                ssvu::getRndI(0, 10) > 8)
+                cPhys.getGame().smashFloor(*getBodyData(mDI.body).tile);
         }
 
         inline void setActive(bool mValue) noexcept
@@ -22,6 +22,8 @@ namespace ob
         ssvs::Animation animation;
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         OBCForceField(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
             OBCIdReceiver& mCIdReceiver, Dir8 mDir, bool mBlockFriendly,
             bool mBlockEnemy, float mForceMult) noexcept
@@ -47,47 +49,49 @@ namespace ob
                 ssvs::getOrbitRad(
                            body.getPosition(), rad - ssvu::piHalf, 1500.f)};
 
-            body.onDetection += [this](const DetectionInfo& mDI)
-            {
-                if(!active) return;
+            cPhys.addHandler(*this);
+        }
+
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            if(!active) return;
+
+            const auto& dirVec(-ssvs::getVecFromRad<float>(rad));
 
-                const auto& dirVec(-ssvs::getVecFromRad<float>(rad));
+            // When something touches the force field, spawn particles
+            game.createPForceField(1, toPixels(mDI.body.getPosition()));
 
-                // When something touches the force field, spawn particles
-                game.createPForceField(1, toPixels(mDI.body.getPosition()));
+            distortion = 10;
 
-                distortion = 10;
+            // If this force field blocks friendlies or enemies and the
+            // detected
+            // body matches...
+            if((blockFriendly && mDI.body.hasGroup(OBGroup::GFriendly)) ||
+                (blockEnemy && mDI.body.hasGroup(OBGroup::GEnemy)))
+            {
+                bool isMoving{mDI.body.getVelocity().x != 0 ||
+                              mDI.body.getVelocity().y != 0};
 
-                // If this force field blocks friendlies or enemies and the
-                // detected
-                // body matches...
-                if((blockFriendly && mDI.body.hasGroup(OBGroup::GFriendly)) ||
-                    (blockEnemy && mDI.body.hasGroup(OBGroup::GEnemy)))
+                // Check if the body is "inside" the force field (check if
+                // it's
+                // on the right side of the segment)
+                if(!segment.isPointLeft(Vec2f(mDI.body.getPosition())))
                 {
-                    bool isMoving{mDI.body.getVelocity().x != 0 ||
-                                  mDI.body.getVelocity().y != 0};
-
-                    // Check if the body is "inside" the force field (check if
-                    // it's
-                    // on the right side of the segment)
-                    if(!segment.isPointLeft(Vec2f(mDI.body.getPosition())))
-                    {
-                        // If it's not inside, push it away from the force field
-                        mDI.body.applyAccel(dirVec * 5.f * forceMult);
-
-                        // If it's moving and it's not inside, treat the
-                        // collision
-                        // as a solid one
-                        if(isMoving &&
-                            isRadBlocked(ssvs::getRad(mDI.body.getVelocity())))
-                            mDI.body.resolvePosition(
-                                ssvsc::Utils::getMin1DIntersection(
-                                    mDI.body.getShape(), body.getShape()));
-                    }
-                    else if(!isMoving)
-                        mDI.body.applyAccel(dirVec * -5.f * forceMult);
+                    // If it's not inside, push it away from the force field
+                    mDI.body.applyAccel(dirVec * 5.f * forceMult);
+
+                    // If it's moving and it's not inside, treat the
+                    // collision
+                    // as a solid one
+                    if(isMoving &&
+                        isRadBlocked(ssvs::getRad(mDI.body.getVelocity())))
+                        mDI.body.resolvePosition(
+                            ssvsc::Utils::getMin1DIntersection(
+                                mDI.body.getShape(), body.getShape()));
                 }
-            };
+                else if(!isMoving)
+                    mDI.body.applyAccel(dirVec * -5.f * forceMult);
+            }
         }
 
         inline void update(FT mFT) override
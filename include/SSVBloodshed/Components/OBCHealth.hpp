@@ -6,11 +6,12 @@
 #define SSVOB_COMPONENTS_HEALTH
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCHealth : public Component
+    class OBCHealth : public Component, public OBLevelAllocated
     {
     private:
         float health, maxHealth;
@@ -6,21 +6,29 @@
 #define SSVOB_COMPONENTS_IDRECEIVER
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCIdReceiver : public Component
+    class OBCIdReceiver : public Component, public OBLevelAllocated
     {
     private:
+        OBGame& game;
         int id;
 
     public:
         ssvu::Delegate<void(IdAction)> onActivate;
 
-        inline OBCIdReceiver(Entity& mE, int mId) : Component{mE}, id{mId}
+        inline OBCIdReceiver(Entity& mE, OBGame& mGame, int mId)
+            : Component{mE}, game(mGame), id{mId}
         {
             getEntity().addGroups(OBGroup::GIdReceiver);
+            game.getIdLinks().add(*this, id);
+        }
+        inline ~OBCIdReceiver() override
+        {
+            game.getIdLinks().remove(*this, id);
         }
 
         inline void activate(IdAction mAction)
@@ -28,7 +36,12 @@ namespace ob
             if(id != -1) onActivate(mAction);
         }
 
-        inline void setId(int mId) noexcept { id = mId; }
+        inline void setId(int mId)
+        {
+            game.getIdLinks().remove(*this, id);
+            id = mId;
+            game.getIdLinks().add(*this, id);
+        }
         inline int getId() const noexcept { return id; }
     };
 
@@ -9,55 +9,21 @@
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
 #include "SSVBloodshed/Components/OBWeightable.hpp"
-#include "SSVBloodshed/Components/OBCTrail.hpp"
 
 namespace ob
 {
-    inline void activateIdReceivers(
-        OBCPhys& mCaller, int mId, IdAction mIdAction, sses::Manager& mManager)
-    {
-        static sf::Color actionColors[]{
-            sf::Color::Yellow, sf::Color::Green, sf::Color::Red};
-
-        for(auto& e : mManager.getEntities(OBGroup::GIdReceiver))
-        {
-            auto& cIdReceiver(e->getComponent<OBCIdReceiver>());
-            if(cIdReceiver.getId() != mId) continue;
-
-            cIdReceiver.activate(mIdAction);
-            mCaller.getFactory().createTrail(mCaller.getPosI(),
-                e->getComponent<OBCPhys>().getPosI(),
-                actionColors[int(mIdAction)]);
-        }
-    }
-
     class OBCPPlate : public OBCActor, public OBWeightable
     {
     private:
-        int id;
+        int id, cluster;
         PPlateType type;
         IdAction idAction;
         bool triggered{false};
 
-        inline std::vector<OBCPPlate*> getNeighbors()
+        // Every plate of the baked cluster, this one included
+        inline const std::vector<OBCPPlate*>& getNeighbors() const
         {
-            std::vector<OBCPPlate*> result;
-            auto query(cPhys.getWorld().getQuery<ssvsc::QueryType::Distance>(
-                cPhys.getPosI(), 1000));
-
-            Body* b;
-            while((b = query.next()) != nullptr)
-            {
-                if(!b->hasGroup(OBGroup::GPPlate)) continue;
-
-                auto& cPPlate(getEntityFromBody(*b).getComponent<OBCPPlate>());
-                if(cPPlate.cPhys.getPosI().x == cPhys.getPosI().x ||
-                    cPPlate.cPhys.getPosI().y == cPhys.getPosI().y)
-                    if(cPPlate.id == id && cPPlate.type == type)
-                        result.emplace_back(&cPPlate);
-            }
-
-            return result;
+            return game.getIdLinks().getPlates(cluster);
         }
 
         inline void triggerNeighbors(bool mTrigger)
@@ -97,14 +63,21 @@ namespace ob
 
     public:
         OBCPPlate(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw, int mId,
-            PPlateType mType, IdAction mIdAction, bool mPlayerOnly) noexcept
+            PPlateType mType, IdAction mIdAction, bool mPlayerOnly,
+            int mCluster)
             : OBCActor{mE, mCPhys, mCDraw},
               OBWeightable{mCPhys, mPlayerOnly},
               id{mId},
+              cluster{mCluster},
               type{mType},
               idAction{mIdAction}
         {
             body.addGroups(OBGroup::GPPlate);
+            game.getIdLinks().addPlate(*this, cluster);
+        }
+        inline ~OBCPPlate() override
+        {
+            game.getIdLinks().removePlate(*this, cluster);
         }
 
         inline void update(FT) override
@@ -112,7 +85,7 @@ namespace ob
             if(hasBeenWeighted() && !triggered)
             {
                 trigger();
-                activateIdReceivers(cPhys, id, idAction, manager);
+                game.getIdLinks().activate(cPhys, id, idAction);
             }
             else if(hasBeenUnweighted() && !isAnyNeighborWeighted())
             {
@@ -121,7 +94,7 @@ namespace ob
                 else if(type == PPlateType::OnOff)
                 {
                     unTrigger();
-                    activateIdReceivers(cPhys, id, idAction, manager);
+                    game.getIdLinks().activate(cPhys, id, idAction);
                 }
             }
 
@@ -6,14 +6,15 @@
 #define SSVOB_COMPONENTS_PARTICLESYSTEM
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/Particles/OBParticleSystem.hpp"
 
 namespace ob
 {
-    class OBCParticleSystem : public Component
+    class OBCParticleSystem : public Component, public OBLevelAllocated
     {
     private:
-        OBParticleSystem particleSystem;
+        OBParticleSystem& particleSystem;
         sf::RenderTexture& renderTexture;
         sf::RenderTarget& renderTarget;
         sf::Sprite sprite;
@@ -22,10 +23,12 @@ namespace ob
         bool clearOnDraw;
 
     public:
-        OBCParticleSystem(Entity& mE, sf::RenderTexture& mRenderTexture,
-            sf::RenderTarget& mRenderTarget, bool mClearOnDraw,
-            unsigned char mAlpha, sf::BlendMode mBlendMode) noexcept
+        OBCParticleSystem(Entity& mE, OBParticleSystem& mParticleSystem,
+            sf::RenderTexture& mRenderTexture, sf::RenderTarget& mRenderTarget,
+            bool mClearOnDraw, unsigned char mAlpha,
+            sf::BlendMode mBlendMode) noexcept
             : Component{mE},
+              particleSystem(mParticleSystem),
               renderTexture(mRenderTexture),
               renderTarget(mRenderTarget),
               blendMode{mBlendMode},
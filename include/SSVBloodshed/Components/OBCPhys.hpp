@@ -6,50 +6,102 @@
 #define SSVOB_COMPONENTS_PHYSICS
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCPhys : public Component
+    class OBCEnemy;
+    class OBCEBall;
+    class OBCShard;
+    class OBCDamageOnTouch;
+    class OBCFloorSmasher;
+    class OBCBooster;
+    class OBWeightable;
+
+    // Body events a collision handler type reacts to
+    namespace OBPhysEvent
+    {
+        enum : int
+        {
+            Detection = 1 << 0,
+            Resolution = 1 << 1,
+            PreUpdate = 1 << 2
+        };
+    }
+
+    class OBCPhys : public Component, public OBLevelAllocated
     {
     private:
         static constexpr int crushedMax{3}, crushedTolerance{1};
         OBGame& game;
         World& world;
         Body& body;
+        OBBodyData bodyData;
         Vec2i lastResolution;
         int crushedLeft{0}, crushedRight{0}, crushedTop{0}, crushedBottom{0};
 
+        // Collision handlers of the owning entity - the body has at most one
+        // delegate per event, which calls the handlers below directly
+        // (dispatch is defined in "OBCPhys.cpp", where every handler type
+        // is complete)
+        std::tuple<OBCEnemy*, OBCEBall*, OBCPlayer*, OBCShard*, OBCProjectile*,
+            OBCDamageOnTouch*, OBCFloorSmasher*, OBCForceField*,
+            OBCBulletForceField*, OBCBooster*, OBWeightable*> handlers{};
+        int hookedEvents{0};
+
+        template <typename T>
+        inline T* getHandler() const noexcept
+        {
+            return std::get<T*>(handlers);
+        }
+
+        inline void hookEvents(int mEvents)
+        {
+            auto added(mEvents & ~hookedEvents);
+            hookedEvents |= mEvents;
+
+            if(added & OBPhysEvent::Detection)
+                body.onDetection += [this](const DetectionInfo& mDI)
+                {
+                    dispatchDetection(mDI);
+                };
+            if(added & OBPhysEvent::Resolution)
+                body.onResolution += [this](const ResolutionInfo& mRI)
+                {
+                    dispatchResolution(mRI);
+                };
+            if(added & OBPhysEvent::PreUpdate)
+                body.onPreUpdate += [this]
+                {
+                    dispatchPreUpdate();
+                };
+        }
+
+        void dispatchDetection(const DetectionInfo& mDI);
+        void dispatchResolution(const ResolutionInfo& mRI);
+        void dispatchPreUpdate();
+
     public:
         OBCPhys(Entity& mE, OBGame& mGame, bool mIsStatic,
             const Vec2i& mPosition, const Vec2i& mSize)
             : Component{mE}, game(mGame), world(mGame.getWorld()),
               body(world.create(mPosition, mSize, mIsStatic))
         {
-            body.setUserData(&getEntity());
-            body.onResolution += [this](const ResolutionInfo& mRI)
-            {
-                lastResolution = mRI.resolution;
-                if(lastResolution.x > 0)
-                    crushedLeft = crushedMax;
-                else if(lastResolution.x < 0)
-                    crushedRight = crushedMax;
-                if(lastResolution.y > 0)
-                    crushedTop = crushedMax;
-                else if(lastResolution.y < 0)
-                    crushedBottom = crushedMax;
-            };
-            body.onPreUpdate += [this]
-            {
-                lastResolution = ssvs::zeroVec2i;
-                if(crushedLeft > 0) --crushedLeft;
-                if(crushedRight > 0) --crushedRight;
-                if(crushedTop > 0) --crushedTop;
-                if(crushedBottom > 0) --crushedBottom;
-            };
+            bodyData.entity = &getEntity();
+            body.setUserData(&bodyData);
+            hookEvents(OBPhysEvent::Resolution | OBPhysEvent::PreUpdate);
         }
         inline ~OBCPhys() override { body.destroy(); }
 
+        // Registers `mHandler` for the events listed in `T::physEvents`
+        template <typename T>
+        inline void addHandler(T& mHandler)
+        {
+            std::get<T*>(handlers) = &mHandler;
+            hookEvents(T::physEvents);
+        }
+
         inline void setPos(const Vec2i& mPos) noexcept
         {
             body.setPosition(mPos);
@@ -67,6 +119,7 @@ namespace ob
         }
         inline World& getWorld() const noexcept { return world; }
         inline Body& getBody() const noexcept { return body; }
+        inline OBBodyData& getBodyData() noexcept { return bodyData; }
         inline const Vec2i& getLastResolution() const noexcept
         {
             return lastResolution;
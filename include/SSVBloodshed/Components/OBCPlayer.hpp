@@ -25,15 +25,7 @@ namespace ob
         friend class OBGameHUD;
 
     public:
-        struct Data
-        {
-            Vec2i pos;
-            int currentWpn;
-            float health;
-            Dir8 dir;
-            int shards;
-            // Ammo and other stuff
-        };
+        using Data = OBPlayerData;
 
         class ComboState
         {
@@ -76,22 +68,18 @@ namespace ob
 
         struct WeaponData
         {
-            OBWpnType wpn;
+            OBWpnTypeId wpn;
             sf::IntRect rect;
-            std::string name;
+            const char* name;
         };
         int currentWpn{0}, currentShards{0}, shards{0};
-        std::vector<WeaponData> weapons{
-            {OBWpnTypes::createMachineGun(), assets.p1Gun, "machine gun"},
-            {OBWpnTypes::createPlasmaBolter(), assets.e1Gun, "plasma bolter"},
-            {OBWpnTypes::createPlasmaCannon(), assets.gunPCannon,
-                "plasma cannon"},
-            {OBWpnTypes::createRocketLauncher(), assets.p2Gun,
-                "rocket launcher"},
-            {OBWpnTypes::createGrenadeLauncher(), assets.p2Gun,
-                "grenade launcher"},
-            {OBWpnTypes::createShockwaveGun(), assets.wpnShockwave,
-                "shockwave gun"}};
+        std::array<WeaponData, 6> weapons{{
+            {WMachineGun, assets.p1Gun, "machine gun"},
+            {WPlasmaBolter, assets.e1Gun, "plasma bolter"},
+            {WPlasmaCannon, assets.gunPCannon, "plasma cannon"},
+            {WRocketLauncher, assets.p2Gun, "rocket launcher"},
+            {WGrenadeLauncher, assets.p2Gun, "grenade launcher"},
+            {WShockwaveGun, assets.wpnShockwave, "shockwave gun"}}};
 
         inline void cycleWeapons(int mDir) noexcept
         {
@@ -103,6 +91,8 @@ namespace ob
         }
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Resolution};
+
         OBCPlayer(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
             OBCKillable& mCKillable, OBCWielder& mCWielder,
             OBCWpnController& mCWpnController) noexcept
@@ -129,10 +119,12 @@ namespace ob
                 OBGroup::GFriendlyKillable, OBGroup::GOrganic,
                 OBGroup::GPlayer);
             body.addGroupsToCheck(OBGroup::GSolidGround);
-            body.onResolution += [this](const ResolutionInfo& mRI)
-            {
-                if(mRI.body.hasGroup(OBGroup::GLevelBound)) checkTransitions();
-            };
+            cPhys.addHandler(*this);
+        }
+
+        inline void handleResolution(const ResolutionInfo& mRI)
+        {
+            if(mRI.body.hasGroup(OBGroup::GLevelBound)) checkTransitions();
         }
 
         inline void updateValidShootingPos()
@@ -199,37 +191,7 @@ namespace ob
 
         inline void attractShards()
         {
-            if(!game.isLevelClear())
-            {
-                auto query(
-                    cPhys.getWorld().getQuery<ssvsc::QueryType::Distance>(
-                        cPhys.getPosI(), 3500));
-
-                Body* b;
-                while((b = query.next()) != nullptr)
-                    if(b->hasGroup(OBGroup::GShard))
-                        b->applyAccel(
-                            Vec2f(cPhys.getPosI() - b->getPosition()) * 0.004f);
-            }
-            else
-            {
-                for(auto& e : manager.getEntities(OBGroup::GShard))
-                {
-                    auto& c(e->getComponent<OBCPhys>());
-                    c.getBody().addGroupsNoResolve(OBGroup::GSolidGround);
-                    if(ssvs::getDistEuclidean(c.getPosI(), cPhys.getPosI()) >
-                        6500)
-                    {
-                        if(ssvs::getMag(c.getVel()) < 650.f)
-                            c.getBody().applyAccel(
-                                Vec2f(cPhys.getPosI() - c.getPosI()) * 0.002f);
-                    }
-                    else
-                        c.setVel(ssvs::getMClampedMax(
-                            Vec2f(cPhys.getPosI() - c.getPosI()) / 1.5f,
-                            400.f));
-                }
-            }
+            game.getShards().attract(cPhys.getPosI(), game.isLevelClear());
         }
 
         inline void checkTransitions()
@@ -252,6 +214,7 @@ namespace ob
             attractShards();
             comboState.update(mFT);
             game.refreshHUD(*this);
+            game.getFlowField().setTarget(cPhys.getPosI());
 
             if(game.isLevelClear())
             {
@@ -274,7 +237,10 @@ namespace ob
                         4.f + k * 0.3f - i * 0.004f);
         }
 
-        inline void shardGrabbed() noexcept { ++currentShards; }
+        inline void shardGrabbed(int mValue) noexcept
+        {
+            currentShards += mValue;
+        }
 
         inline void initFromData(const Data& mData) noexcept
         {
@@ -8,22 +8,34 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCActorBase.hpp"
-#include "SSVBloodshed/Components/OBCFloor.hpp"
 #include "SSVBloodshed/Components/OBCHealth.hpp"
 
 namespace ob
 {
     class OBCProjectile : public OBCActor
     {
+        friend class OBGProjectiles;
+
     private:
-        Ticker tckLife{150.f};
         OBCActorND* shooter{nullptr};
-        float acceleration{0.f}, minSpeed{0}, maxSpeed{1000}, dmgMult{1.f},
-            curveSpeed{0.f}, dmg{1};
+        float dmgMult{1.f}, dmg{1};
         OBGroup targetGroup{OBGroup::GEnemyKillable};
         int pierceOrganic{0};
         bool bounce{false}, fallInPit{false}, killDestructible{false};
 
+        SizeT projectileIdx;
+
+        // Flight state lives in the game's projectile store, which steers
+        // and ages every projectile in one pass instead of an update each
+        inline OBGProjectiles::Flight& getFlight() const noexcept
+        {
+            return game.getProjectiles().getFlight(projectileIdx);
+        }
+        inline OBGProjectiles::Life& getLifeState() const noexcept
+        {
+            return game.getProjectiles().getLife(projectileIdx);
+        }
+
         inline void refreshMult()
         {
             if(targetGroup == OBGroup::GEnemyKillable)
@@ -35,6 +47,8 @@ namespace ob
         }
 
     public:
+        static constexpr int physEvents{OBPhysEvent::Detection};
+
         ssvu::Delegate<void()> onDestroy;
 
         inline OBCProjectile(Entity& mE, OBCActorND* mShooter, OBCPhys& mCPhys,
@@ -48,62 +62,58 @@ namespace ob
             body.addGroupsNoResolve(
                 OBGroup::GFriendly, OBGroup::GEnemy, OBGroup::GProjectile);
             body.setResolve(false);
-            body.onDetection += [this](const DetectionInfo& mDI)
-            {
-                if(fallInPit && mDI.body.hasGroup(OBGroup::GPit))
-                    getEntity().destroy();
-
-                SSVU_ASSERT(shooter != nullptr);
-                auto shooterStat(shooter->getEntity().getStat());
-
-                if(killDestructible &&
-                    mDI.body.hasGroup(OBGroup::GEnvDestructible))
-                {
-                    // getComponentFromBody<OBCHealth>(mDI.body).damage(sses::getNullEntityStat(),
-                    // nullptr, 100000); ???
-                    getComponentFromBody<OBCHealth>(mDI.body).damage(
-                        shooterStat, shooter, 100000);
-                    destroy();
-                }
-
-                if(mDI.body.hasGroup(targetGroup) &&
-                    getComponentFromBody<OBCHealth>(mDI.body).damage(
-                        shooterStat, shooter, dmg * dmgMult) &&
-                    pierceOrganic-- == 0)
-                {
-                    destroy();
-                }
-                else if(!mDI.body.hasGroup(OBGroup::GOrganic) &&
-                        mDI.body.hasGroup(OBGroup::GSolidAir))
-                {
-                    if(bounce) return;
-                    game.createPDebris(6, cPhys.getPosPx());
-                    assets.playSound("Sounds/bulletHitWall.wav");
-                    destroy();
-                }
-            };
             body.setRestitutionX(1.f);
             body.setRestitutionY(1.f);
+            cPhys.addHandler(*this);
 
             refreshMult();
+            game.getProjectiles().add(*this);
         }
-        inline void destroy()
+        inline ~OBCProjectile() override
         {
-            getEntity().destroy();
-            onDestroy();
+            game.getProjectiles().remove(*this);
         }
-
-        inline void update(FT mFT) override
+        inline void handleDetection(const DetectionInfo& mDI)
         {
-            auto newVel(body.getVelocity());
-            ssvs::resize(newVel, ssvs::getMag(newVel) + acceleration * mFT);
-            ssvs::mClamp(newVel, minSpeed, maxSpeed);
+            if(fallInPit && mDI.body.hasGroup(OBGroup::GPit))
+                getEntity().destroy();
 
-            body.setVelocity(ssvs::getVecFromRad(
-                ssvs::getRad(newVel) + curveSpeed * mFT, ssvs::getMag(newVel)));
+            SSVU_ASSERT(shooter != nullptr);
+            auto shooterStat(shooter->getEntity().getStat());
 
-            if(tckLife.update(mFT)) destroy();
+            if(killDestructible &&
+                mDI.body.hasGroup(OBGroup::GEnvDestructible))
+            {
+                // getComponentFromBody<OBCHealth>(mDI.body).damage(sses::getNullEntityStat(),
+                // nullptr, 100000); ???
+                getComponentFromBody<OBCHealth>(mDI.body).damage(
+                    shooterStat, shooter, 100000);
+                destroy();
+            }
+
+            if(mDI.body.hasGroup(targetGroup) &&
+                getComponentFromBody<OBCHealth>(mDI.body).damage(
+                    shooterStat, shooter, dmg * dmgMult) &&
+                pierceOrganic-- == 0)
+            {
+                destroy();
+            }
+            else if(!mDI.body.hasGroup(OBGroup::GOrganic) &&
+                    mDI.body.hasGroup(OBGroup::GSolidAir))
+            {
+                if(bounce) return;
+                game.createPDebris(6, cPhys.getPosPx());
+                assets.playSound("Sounds/bulletHitWall.wav");
+                destroy();
+            }
         }
+        inline void destroy()
+        {
+            getEntity().destroy();
+            game.getProjectiles().kill(projectileIdx);
+            onDestroy();
+        }
+
         inline void draw() override
         {
             cDraw.setRotation(ssvs::getDeg(body.getVelocity()));
@@ -117,10 +127,13 @@ namespace ob
             return pj;
         }
 
-        inline void setLife(float mValue) noexcept { tckLife.restart(mValue); }
+        inline void setLife(float mValue) noexcept
+        {
+            getLifeState() = {0.f, mValue};
+        }
         inline void setCurveSpeed(float mValue) noexcept
         {
-            curveSpeed = mValue;
+            getFlight().curveSpeed = mValue;
         }
         inline void setDamage(float mValue) noexcept { dmg = mValue; }
         inline void setPierceOrganic(int mValue) noexcept
@@ -138,10 +151,16 @@ namespace ob
         }
         inline void setAcceleration(float mValue) noexcept
         {
-            acceleration = mValue;
+            getFlight().acceleration = mValue;
+        }
+        inline void setMinSpeed(float mValue) noexcept
+        {
+            getFlight().minSpeed = mValue;
+        }
+        inline void setMaxSpeed(float mValue) noexcept
+        {
+            getFlight().maxSpeed = mValue;
         }
-        inline void setMinSpeed(float mValue) noexcept { minSpeed = mValue; }
-        inline void setMaxSpeed(float mValue) noexcept { maxSpeed = mValue; }
         inline void setBounce(bool mValue) noexcept
         {
             bounce = mValue;
@@ -153,8 +172,14 @@ namespace ob
         }
         inline void setFallInPit(bool mValue) noexcept { fallInPit = mValue; }
 
-        inline float getLife() const noexcept { return tckLife.getCurrent(); }
-        inline float getCurveSpeed() const noexcept { return curveSpeed; }
+        inline float getLife() const noexcept
+        {
+            return getLifeState().current;
+        }
+        inline float getCurveSpeed() const noexcept
+        {
+            return getFlight().curveSpeed;
+        }
         inline float getDamage() const noexcept { return dmg; }
         inline float getSpeed() const noexcept
         {
@@ -13,7 +13,16 @@ namespace ob
 {
     class OBCShard : public OBCActor
     {
+        friend class OBGShards;
+
+    private:
+        int value{1};
+        SizeT shardIdx;
+
     public:
+        static constexpr int physEvents{
+            OBPhysEvent::Detection | OBPhysEvent::PreUpdate};
+
         OBCShard(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw) noexcept
             : OBCActor{mE, mCPhys, mCDraw}
         {
@@ -23,19 +32,7 @@ namespace ob
             body.addGroupsNoResolve(OBGroup::GOrganic, OBGroup::GPit);
             body.setRestitutionX(0.8f);
             body.setRestitutionY(0.8f);
-            body.onPreUpdate += [this]
-            {
-                body.setVelocity(
-                    ssvs::getCClampedMax(body.getVelocity() * 0.99f, 500.f));
-            };
-            body.onDetection += [this](const DetectionInfo& mDI)
-            {
-                if(!mDI.body.hasGroup(OBGroup::GPlayer)) return;
-
-                getComponentFromBody<OBCPlayer>(mDI.body).shardGrabbed();
-                getEntity().destroy();
-                game.createPShard(20, cPhys.getPosPx());
-            };
+            cPhys.addHandler(*this);
 
             body.setVelocity(
                 ssvs::getVecFromRad(ssvu::getRndR<float>(0.f, ssvu::tau),
@@ -43,12 +40,41 @@ namespace ob
             cDraw.setBlendMode(sf::BlendAdd);
             cDraw.setGlobalScale(0.65f);
             cDraw.setRotation(ssvu::getRndI(0, 360));
+
+            game.getShards().add(*this);
+        }
+        inline ~OBCShard() override { game.getShards().remove(*this); }
+
+        inline void handlePreUpdate()
+        {
+            body.setVelocity(
+                ssvs::getCClampedMax(body.getVelocity() * 0.99f, 500.f));
+        }
+        inline void handleDetection(const DetectionInfo& mDI)
+        {
+            if(value == 0 || !mDI.body.hasGroup(OBGroup::GPlayer)) return;
+
+            getComponentFromBody<OBCPlayer>(mDI.body).shardGrabbed(value);
+            getEntity().destroy();
+            game.createPShard(20 + value, cPhys.getPosPx());
+            value = 0;
         }
 
         inline void update(FT) override
         {
             cDraw[0].rotate(ssvs::getMag(body.getVelocity()) * 0.01f);
         }
+
+        // Takes over `mShard`'s value, which then disappears
+        inline void absorb(OBCShard& mShard)
+        {
+            value += mShard.value;
+            mShard.value = 0;
+            mShard.getEntity().destroy();
+            cDraw.setGlobalScale(0.65f * std::sqrt(float(value)));
+        }
+
+        inline int getValue() const noexcept { return value; }
     };
 }
 
@@ -14,48 +14,51 @@ namespace ob
     class OBCTargeter : public OBCActorND
     {
     private:
-        OBCPhys* target{nullptr};
-        OBGroup targetGroup;
-        sses::EntityStat targetStat;
+        const OBGTargetRegistry& registry;
+        int slot{OBGTargetRegistry::nullSlot}, aiIdx{-1};
         float distance{0.f};
 
     public:
-        OBCTargeter(Entity& mE, OBCPhys& mCPhys, OBGroup mTargetGroup) noexcept
+        OBCTargeter(Entity& mE, OBCPhys& mCPhys) noexcept
             : OBCActorND{mE, mCPhys},
-              targetGroup(mTargetGroup)
+              registry(game.getTargetRegistry())
         {
         }
 
+        // Targets are picked by the AI scheduler, along with the owner's
+        // decisions - targeters created this frame pick one in the next
         inline void update(FT) override
         {
-            if(target == nullptr)
-            {
-                if(manager.hasEntity(targetGroup))
-                {
-                    const auto& e(manager.getEntities(targetGroup).front());
-                    targetStat = e->getStat();
-                    target = &e->getComponent<OBCPhys>();
-                }
-            }
-            else
-            {
-                distance =
-                    ssvs::getDistEuclidean(target->getPosF(), cPhys.getPosF());
-                if(!manager.isAlive(targetStat)) target = nullptr;
-            }
+            if(aiIdx == -1) return;
+
+            const auto& d(game.getAIScheduler().getDecision(aiIdx));
+            slot = d.slot;
+            if(slot != OBGTargetRegistry::nullSlot) distance = d.dist;
         }
 
+        inline void setAIIdx(int mValue) noexcept { aiIdx = mValue; }
+
         inline bool hasTarget() const noexcept
         {
-            return target != nullptr && manager.isAlive(targetStat);
+            return registry.isAlive(slot) &&
+                   manager.isAlive(registry[slot].stat);
+        }
+        inline OBCPhys& getTarget() const noexcept
+        {
+            return *registry[slot].cPhys;
+        }
+        inline const Vec2f& getPosF() const noexcept
+        {
+            return registry[slot].posF;
         }
-        inline OBCPhys& getTarget() const noexcept { return *target; }
-        inline Vec2f getPosF() const noexcept { return target->getPosF(); }
         inline const Vec2i& getPosI() const noexcept
         {
-            return target->getPosI();
+            return registry[slot].posI;
+        }
+        inline const Vec2f& getVel() const noexcept
+        {
+            return registry[slot].vel;
         }
-        inline const Vec2f& getVel() const noexcept { return target->getVel(); }
         inline float getDist() const noexcept { return distance; }
     };
 }
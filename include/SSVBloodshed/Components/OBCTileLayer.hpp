@@ -0,0 +1,100 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_COMPONENTS_TILELAYER
+#define SSVOB_COMPONENTS_TILELAYER
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
+
+namespace ob
+{
+    // Level tile without per-frame behavior (wall, pit, floor)
+    struct OBTile
+    {
+        OBBodyData bodyData;
+        Body* body{nullptr};
+        SizeT vertexIdx;
+        bool smashed{false};
+    };
+
+    // Draws all the tiles of a layer as a single vertex array and owns their
+    // bodies - tiles don't have entities, so the manager never visits them
+    class OBCTileLayer : public Component, public OBLevelAllocated
+    {
+    private:
+        World& world;
+        sf::RenderTarget& renderTarget;
+        sf::Texture& texture;
+        std::vector<sf::Vertex> vertices;
+        std::deque<OBTile> tiles; // Bodies point to their tile's data
+
+    public:
+        OBCTileLayer(Entity& mE, World& mWorld, sf::RenderTarget& mRenderTarget,
+            sf::Texture& mTexture) noexcept : Component{mE},
+                                              world(mWorld),
+                                              renderTarget(mRenderTarget),
+                                              texture(mTexture)
+        {
+        }
+        inline ~OBCTileLayer() override
+        {
+            for(auto& t : tiles)
+                if(t.body != nullptr) t.body->destroy();
+        }
+
+        inline void draw() override
+        {
+            renderTarget.draw(vertices.data(), vertices.size(), sf::Quads,
+                sf::RenderStates{&texture});
+        }
+
+        inline OBTile& emplaceTile(const Vec2i& mPos, const sf::IntRect& mRect)
+        {
+            tiles.emplace_back();
+            auto& result(tiles.back());
+            result.bodyData.entity = &getEntity();
+            result.bodyData.tile = &result;
+            result.vertexIdx = vertices.size();
+
+            const auto& center(toPixels(mPos));
+            Vec2f halfSize{mRect.width / 2.f, mRect.height / 2.f};
+            vertices.emplace_back(center - halfSize);
+            vertices.emplace_back(center + Vec2f{halfSize.x, -halfSize.y});
+            vertices.emplace_back(center + halfSize);
+            vertices.emplace_back(center + Vec2f{-halfSize.x, halfSize.y});
+            setTextureRect(result, mRect);
+
+            return result;
+        }
+        inline Body& createBody(OBTile& mTile, const Vec2i& mPos)
+        {
+            SSVU_ASSERT(mTile.body == nullptr);
+            auto& result(world.create(mPos, {1000, 1000}, true));
+            result.setUserData(&mTile.bodyData);
+            mTile.body = &result;
+            return result;
+        }
+
+        inline void setTextureRect(
+            const OBTile& mTile, const sf::IntRect& mRect) noexcept
+        {
+            auto* v(&vertices[mTile.vertexIdx]);
+            Vec2f tl(mRect.left, mRect.top);
+            v[0].texCoords = tl;
+            v[1].texCoords = tl + Vec2f(mRect.width, 0);
+            v[2].texCoords = tl + Vec2f(mRect.width, mRect.height);
+            v[3].texCoords = tl + Vec2f(0, mRect.height);
+        }
+        inline void hideTile(const OBTile& mTile) noexcept
+        {
+            auto* v(&vertices[mTile.vertexIdx]);
+            for(auto i(0u); i < 4; ++i) v[i].color = sf::Color::Transparent;
+        }
+
+        inline SizeT getTileCount() const noexcept { return tiles.size(); }
+    };
+}
+
+#endif
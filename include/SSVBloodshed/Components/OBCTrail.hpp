@@ -6,37 +6,74 @@
 #define SSVOB_COMPONENTS_TRAIL
 
 #include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 
 namespace ob
 {
-    class OBCTrail : public Component
+    // Links an id source to every receiver it activated - the game keeps
+    // at most one trail per (source, id) pair and restarts it on refire
+    class OBCTrail : public Component, public OBLevelAllocated
     {
     private:
+        static constexpr float maxLife{75};
+
         OBGame& game;
-        float life{75};
-        Vec2f a, b;
+        const OBCPhys* source;
+        int id;
+        float life{maxLife};
+        Vec2f a;
+        std::vector<Vec2f> targets;
         sf::Color color;
         ssvs::VertexVector<sf::PrimitiveType::Lines> vertices;
 
     public:
-        OBCTrail(Entity& mE, OBGame& mGame, const Vec2i& mA, const Vec2i& mB,
-            const sf::Color& mColor)
-            : Component{mE}, game(mGame), a{toPixels(mA)}, b{toPixels(mB)},
-              color{mColor}, vertices{2}
+        OBCTrail(Entity& mE, OBGame& mGame, const OBCPhys& mSource, int mId,
+            const Vec2i& mA, const sf::Color& mColor)
+            : Component{mE}, game(mGame), source{&mSource}, id{mId},
+              a{toPixels(mA)}, color{mColor}
+        {
+            game.getIdLinks().addTrail(mSource, id, *this);
+        }
+        inline ~OBCTrail() override
         {
+            game.getIdLinks().removeTrail(source, id, *this);
+        }
+
+        inline void restart(const Vec2i& mA, const sf::Color& mColor)
+        {
+            life = maxLife;
+            a = toPixels(mA);
+            color = mColor;
+            targets.clear();
+        }
+        inline void addTarget(const Vec2i& mB)
+        {
+            targets.emplace_back(toPixels(mB));
         }
 
         inline void update(FT mFT) override
         {
             life -= mFT;
-            if(life <= 0) getEntity().destroy();
+            if(life <= 0)
+            {
+                // Refires from now on start a new trail
+                game.getIdLinks().removeTrail(source, id, *this);
+                getEntity().destroy();
+            }
+
             color.a = life * (255 / 100);
-            vertices[0].color = vertices[1].color = color;
-            vertices[0].position =
-                a + Vec2f(ssvu::getRndI(-1, 1), ssvu::getRndI(-1, 1));
-            vertices[1].position =
-                b + Vec2f(ssvu::getRndI(-1, 1), ssvu::getRndI(-1, 1));
+            vertices.resize(targets.size() * 2);
+            for(auto i(0u); i < targets.size(); ++i)
+            {
+                auto& v0(vertices[i * 2]);
+                auto& v1(vertices[i * 2 + 1]);
+                v0.color = v1.color = color;
+                v0.position =
+                    a + Vec2f(ssvu::getRndI(-1, 1), ssvu::getRndI(-1, 1));
+                v1.position = targets[i] +
+                              Vec2f(ssvu::getRndI(-1, 1), ssvu::getRndI(-1, 1));
+            }
         }
         inline void draw() override { game.render(vertices); }
     };
@@ -30,7 +30,7 @@ namespace ob
 
     public:
         OBCTurret(Entity& mE, OBCPhys& mCPhys, OBCDraw& mCDraw,
-            OBCKillable& mCKillable, Dir8 mDir, const OBWpnType& mWpn,
+            OBCKillable& mCKillable, Dir8 mDir, OBWpnTypeId mWpn,
             float mShootDelay, float mPJDelay, int mShootCount) noexcept
             : OBCActor{mE, mCPhys, mCDraw},
               cKillable(mCKillable),
@@ -57,7 +57,7 @@ namespace ob
 
             cKillable.onDeath += [this]
             {
-                game.createEShard(5, cPhys.getPosI());
+                game.getCommands().spawnShards(cPhys.getPosI(), 5);
             };
         }
         inline void update(FT mFT) override
@@ -38,13 +38,13 @@ namespace ob
             {
                 cDraw[0].setTextureRect(rectShoot);
                 cDraw[1].setRotation(cDir8.getDeg() - 90);
-                cDraw.getOffsets()[1] = cDir8.getVec(wieldDist);
+                cDraw.setOffset(1, cDir8.getVec(wieldDist));
             }
             else
             {
                 cDraw[0].setTextureRect(rectStand);
                 cDraw[1].setRotation(cDir8.getDeg());
-                cDraw.getOffsets()[1] = cDir8.getVec(holdDist);
+                cDraw.setOffset(1, cDir8.getVec(holdDist));
             }
         }
         inline void setHoldDist(float mValue) noexcept { holdDist = mValue; }
@@ -42,9 +42,9 @@ namespace ob
             return true;
         }
 
-        inline void setWpn(const OBWpnType& mWpn) noexcept { wpn.setWpn(mWpn); }
+        inline void setWpn(OBWpnTypeId mWpn) noexcept { wpn.setWpn(mWpn); }
 
-        inline OBWpnType& getWpn() noexcept { return wpn.getWpnType(); }
+        inline const OBWpnType& getWpn() const { return wpn.getWpnType(); }
         inline const Ticker& getTicker() const noexcept { return tckShoot; }
         inline Ticker& getTicker() noexcept { return tckShoot; }
     };
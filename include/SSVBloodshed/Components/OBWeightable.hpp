@@ -18,6 +18,9 @@ namespace ob
         bool wasWeighted{false}, weighted{false}, playerOnly;
 
     public:
+        static constexpr int physEvents{
+            OBPhysEvent::Detection | OBPhysEvent::PreUpdate};
+
         OBWeightable(OBCPhys& mCPhys, bool mPlayerOnly) noexcept
             : bodyWeightable(mCPhys.getBody()),
               playerOnly{mPlayerOnly}
@@ -25,18 +28,16 @@ namespace ob
             bodyWeightable.setResolve(false);
             bodyWeightable.addGroupsToCheck(
                 OBGroup::GFriendly, OBGroup::GEnemy);
+            mCPhys.addHandler(*this);
+        }
 
-            bodyWeightable.onPreUpdate += [this]
-            {
-                weighted = false;
-            };
-            bodyWeightable.onDetection += [this](const DetectionInfo& mDI)
-            {
-                if(mDI.body.hasGroup(OBGroup::GFlying)) return;
-                if((!playerOnly && mDI.body.hasGroup(OBGroup::GEnemy)) ||
-                    mDI.body.hasGroup(OBGroup::GFriendly))
-                    weighted = true;
-            };
+        inline void handlePreUpdate() noexcept { weighted = false; }
+        inline void handleDetection(const DetectionInfo& mDI) noexcept
+        {
+            if(mDI.body.hasGroup(OBGroup::GFlying)) return;
+            if((!playerOnly && mDI.body.hasGroup(OBGroup::GEnemy)) ||
+                mDI.body.hasGroup(OBGroup::GFriendly))
+                weighted = true;
         }
         inline void refresh() { wasWeighted = weighted; }
 
@@ -0,0 +1,402 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_BAKE
+#define SSVOB_LEVELEDITOR_BAKE
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <tuple>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/LevelEditor/OBLESpawn.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEPack.hpp"
+#include "SSVBloodshed/LevelEditor/OBLESector.hpp"
+#include "SSVBloodshed/LevelEditor/OBLELevel.hpp"
+#include "SSVBloodshed/LevelEditor/OBLETile.hpp"
+
+namespace ob
+{
+    // Spawn indices of the sources (pressure plates) and receivers of an id
+    struct OBLEIdLink
+    {
+        std::vector<std::uint32_t> sources, receivers;
+    };
+
+    // Everything needed to instantiate a level, in spawn order - only
+    // depends on the level's tiles, so it can be computed offline
+    struct OBLEBakedLevel
+    {
+        // Hash of the level it was baked from - see `getLevelHash`
+        std::uint64_t sourceHash{0};
+
+        std::vector<OBLESpawn> spawns;
+        std::map<int, OBLEIdLink> idLinks;
+
+        // Adjacent plates with the same id and type trigger together
+        std::vector<std::vector<std::uint32_t>> plateClusters;
+    };
+
+    inline bool isConnectedType(OBLETType mType) noexcept
+    {
+        return mType == OBLETType::LETWall || mType == OBLETType::LETWallD ||
+               mType == OBLETType::LETDoor || mType == OBLETType::LETDoorG ||
+               mType == OBLETType::LETDoorR;
+    }
+    inline bool isPPlateType(OBLETType mType) noexcept
+    {
+        return mType == OBLETType::LETPPlateSingle ||
+               mType == OBLETType::LETPPlateMulti ||
+               mType == OBLETType::LETPPlateOnOff;
+    }
+
+    // Bits 0 to 3 are set for the neighbors of the same type above, to the
+    // right, below and to the left
+    inline int getWallMask(
+        const OBLELevel& mL, OBLETType mType, int mX, int mY, int mZ)
+    {
+        auto tileIs = [&mL, mType, mZ](int mTX, int mTY)
+        {
+            return mL.isValid(mTX, mTY, mZ) &&
+                   mL.getTile(mTX, mTY, mZ).getType() == mType;
+        };
+
+        return tileIs(mX, mY - 1) << 0 | tileIs(mX + 1, mY) << 1 |
+               tileIs(mX, mY + 1) << 2 | tileIs(mX - 1, mY) << 3;
+    }
+
+    // FNV-1a hash of everything baking reads from a level: its size and
+    // every non-null tile's position, type and params
+    inline std::uint64_t getLevelHash(const OBLELevel& mL) noexcept
+    {
+        std::uint64_t result{14695981039346656037ull};
+        auto add([&result](std::int32_t mValue)
+            {
+                for(auto i(0u); i < sizeof(mValue); ++i)
+                {
+                    result ^= std::uint8_t(std::uint32_t(mValue) >> (i * 8));
+                    result *= 1099511628211ull;
+                }
+            });
+
+        add(mL.getColumns());
+        add(mL.getRows());
+        add(mL.getDepth());
+        mL.forTiles([&add](const OBLETile& mT)
+            {
+                add(mT.getX());
+                add(mT.getY());
+                add(mT.getZ());
+                add(int(mT.getType()));
+
+                const auto& params(mT.getParams());
+                params.forEach([&add, &params](OBLEPKey mKey)
+                    {
+                        add(int(mKey));
+                        if(getPKeyInfo(mKey).type != OBLEPType::Real)
+                        {
+                            add(params.get<int>(mKey));
+                            return;
+                        }
+
+                        auto value(params.get<float>(mKey));
+                        std::int32_t bits;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        add(bits);
+                    });
+            });
+
+        return result;
+    }
+
+    inline OBLEBakedLevel bakeLevel(const OBLELevel& mL)
+    {
+        OBLEBakedLevel result;
+        result.sourceHash = getLevelHash(mL);
+        std::map<std::tuple<int, int, int>, std::uint32_t> plates;
+
+        mL.forTiles([&mL, &result, &plates](const OBLETile& mT)
+            {
+                auto type(mT.getType());
+                auto idx(std::uint32_t(result.spawns.size()));
+
+                OBLESpawn s;
+                std::memset(&s, 0, sizeof(s));
+                s.params = mT.getParams();
+                s.type = type;
+                s.x = mT.getX();
+                s.y = mT.getY();
+                s.z = mT.getZ();
+                s.cluster = -1;
+                if(isConnectedType(type))
+                    s.mask = getWallMask(mL, type, s.x, s.y, s.z);
+                result.spawns.emplace_back(s);
+
+                if(!mT.hasParam(OBLEPKey::Id)) return;
+
+                auto id(mT.getParam<int>(OBLEPKey::Id));
+                if(isPPlateType(type))
+                {
+                    plates[std::make_tuple(s.x, s.y, s.z)] = idx;
+                    result.idLinks[id].sources.emplace_back(idx);
+                }
+                else if(id != -1)
+                    result.idLinks[id].receivers.emplace_back(idx);
+            });
+
+        // Clusters are the connected groups of plates on a layer - flood
+        // fill them in position order, so that baking is deterministic
+        for(const auto& p : plates)
+        {
+            if(result.spawns[p.second].cluster != -1) continue;
+
+            auto cluster(std::int32_t(result.plateClusters.size()));
+            result.plateClusters.emplace_back();
+            std::vector<std::uint32_t> stack{p.second};
+            result.spawns[p.second].cluster = cluster;
+
+            while(!stack.empty())
+            {
+                auto idx(stack.back());
+                stack.pop_back();
+                result.plateClusters.back().emplace_back(idx);
+
+                const auto& s(result.spawns[idx]);
+                for(auto d : {std::make_pair(0, -1), std::make_pair(1, 0),
+                        std::make_pair(0, 1), std::make_pair(-1, 0)})
+                {
+                    auto itr(plates.find(std::make_tuple(
+                        s.x + d.first, s.y + d.second, s.z)));
+                    if(itr == std::end(plates)) continue;
+
+                    auto& n(result.spawns[itr->second]);
+                    if(n.cluster != -1 || n.type != s.type ||
+                        n.params.get<int>(OBLEPKey::Id) !=
+                            s.params.get<int>(OBLEPKey::Id))
+                        continue;
+
+                    n.cluster = cluster;
+                    stack.emplace_back(itr->second);
+                }
+            }
+
+            ssvu::sort(result.plateClusters.back());
+        }
+
+        return result;
+    }
+
+    // Version 3 stores a hash of every level's source, earlier versions
+    // identified the whole source pack
+    namespace OBLEBakedBin
+    {
+        constexpr char magic[4]{'O', 'B', 'B', 'K'};
+        constexpr std::uint32_t version{3}, byteOrder{0x01020304};
+    }
+
+    // Baked levels of a whole pack, keyed by sector index and level key
+    //
+    // The file is a header followed by one record per level: its source
+    // hash, its spawns as raw `OBLESpawn`s, its id links and its plate
+    // clusters - all in host byte order, like binary packs
+    class OBLEBakedPack
+    {
+    private:
+        using u32 = std::uint32_t;
+
+        std::map<std::pair<int, int>, OBLEBakedLevel> levels;
+
+        template <typename T>
+        inline static void put(std::ostream& mOut, const T& mValue)
+        {
+            mOut.write(reinterpret_cast<const char*>(&mValue), sizeof(T));
+        }
+        template <typename T>
+        inline static void putVec(std::ostream& mOut, const std::vector<T>& mV)
+        {
+            put(mOut, u32(mV.size()));
+            mOut.write(reinterpret_cast<const char*>(mV.data()),
+                mV.size() * sizeof(T));
+        }
+
+        template <typename T>
+        inline static T get(std::istream& mIn)
+        {
+            T result;
+            if(!mIn.read(reinterpret_cast<char*>(&result), sizeof(T)))
+                throw std::runtime_error{"Baked pack is truncated"};
+            return result;
+        }
+        // Sizes are checked against the rest of the file before allocating
+        template <typename T>
+        inline static std::vector<T> getVec(std::istream& mIn, SizeT mMax)
+        {
+            auto size(get<u32>(mIn));
+            auto pos(mIn.tellg());
+            mIn.seekg(0, std::ios::end);
+            auto left(SizeT(mIn.tellg() - pos));
+            mIn.seekg(pos);
+
+            if(size > mMax || size > left / sizeof(T))
+                throw std::runtime_error{"Baked pack record out of bounds"};
+
+            std::vector<T> result(size);
+            if(!mIn.read(reinterpret_cast<char*>(result.data()),
+                   size * sizeof(T)))
+                throw std::runtime_error{"Baked pack is truncated"};
+            return result;
+        }
+
+        inline static void checkIdxs(
+            const std::vector<u32>& mIdxs, SizeT mSpawnCount)
+        {
+            for(auto i : mIdxs)
+                if(i >= mSpawnCount)
+                    throw std::runtime_error{"Baked pack index out of bounds"};
+        }
+
+        // Spawning switches on the tile type, reads every param of the
+        // type's schema (enum params index their enum) and indexes the wall
+        // sprites by mask
+        inline static void checkSpawns(const std::vector<OBLESpawn>& mSpawns)
+        {
+            for(const auto& s : mSpawns)
+            {
+                if(!isValidTType(int(s.type)) || s.type == OBLETType::LETNull)
+                    throw std::runtime_error{"Baked pack spawn type unknown"};
+                if(s.mask > 15)
+                    throw std::runtime_error{"Baked pack mask out of bounds"};
+
+                const auto& schema(getSchema(s.type));
+                for(const auto& d : schema.getDefs())
+                {
+                    if(!s.params.has(d.key))
+                        throw std::runtime_error{
+                            "Baked pack spawn is missing params"};
+
+                    auto value(s.params.get<float>(d.key));
+                    if(!(value >= d.min && value <= schema.getMax(d)))
+                        throw std::runtime_error{
+                            "Baked pack param out of range"};
+                }
+            }
+        }
+
+    public:
+        // Stored levels are read one at a time and not kept resident
+        inline static OBLEBakedPack bake(const OBLEPack& mPack)
+        {
+            OBLEBakedPack result;
+
+            for(const auto& s : mPack.getSectors())
+                mPack.forLevels(s.second, [&result, &s](int mKey,
+                                              const OBLELevel& mL)
+                    {
+                        result.levels[{s.first, mKey}] = bakeLevel(mL);
+                    });
+
+            return result;
+        }
+
+        inline void writeToFile(const std::string& mPath) const
+        {
+            using namespace OBLEBakedBin;
+
+            std::ofstream ofs{mPath, std::ios::binary};
+            ofs.write(magic, 4);
+            put(ofs, version);
+            put(ofs, byteOrder);
+            put(ofs, u32(levels.size()));
+
+            for(const auto& l : levels)
+            {
+                const auto& bl(l.second);
+                put(ofs, std::int32_t(l.first.first));
+                put(ofs, std::int32_t(l.first.second));
+                put(ofs, bl.sourceHash);
+                putVec(ofs, bl.spawns);
+
+                put(ofs, u32(bl.idLinks.size()));
+                for(const auto& p : bl.idLinks)
+                {
+                    put(ofs, std::int32_t(p.first));
+                    putVec(ofs, p.second.sources);
+                    putVec(ofs, p.second.receivers);
+                }
+
+                put(ofs, u32(bl.plateClusters.size()));
+                for(const auto& c : bl.plateClusters) putVec(ofs, c);
+            }
+
+            if(!ofs) throw std::runtime_error{"Can't write " + mPath};
+        }
+
+        inline static OBLEBakedPack readFromFile(const std::string& mPath)
+        {
+            using namespace OBLEBakedBin;
+
+            std::ifstream ifs{mPath, std::ios::binary};
+            if(!ifs) throw std::runtime_error{"Can't open " + mPath};
+
+            char head[4];
+            if(!ifs.read(head, 4) || std::memcmp(head, magic, 4) != 0)
+                throw std::runtime_error{"Not a baked pack"};
+            if(get<u32>(ifs) != version)
+                throw std::runtime_error{"Unsupported baked pack version"};
+            if(get<u32>(ifs) != byteOrder)
+                throw std::runtime_error{"Baked pack has another byte order"};
+
+            OBLEBakedPack result;
+            auto levelCount(get<u32>(ifs));
+            for(auto i(0u); i < levelCount; ++i)
+            {
+                auto sector(get<std::int32_t>(ifs));
+                auto key(get<std::int32_t>(ifs));
+                auto& bl(result.levels[{sector, key}]);
+                bl.sourceHash = get<std::uint64_t>(ifs);
+                bl.spawns = getVec<OBLESpawn>(ifs, u32(-1));
+                auto spawnCount(bl.spawns.size());
+                checkSpawns(bl.spawns);
+
+                auto linkCount(get<u32>(ifs));
+                for(auto j(0u); j < linkCount; ++j)
+                {
+                    auto& link(bl.idLinks[get<std::int32_t>(ifs)]);
+                    link.sources = getVec<u32>(ifs, spawnCount);
+                    link.receivers = getVec<u32>(ifs, spawnCount);
+                    checkIdxs(link.sources, spawnCount);
+                    checkIdxs(link.receivers, spawnCount);
+                }
+
+                auto clusterCount(get<u32>(ifs));
+                if(clusterCount > spawnCount)
+                    throw std::runtime_error{"Baked pack record out of bounds"};
+                bl.plateClusters.resize(clusterCount);
+                for(auto& c : bl.plateClusters)
+                {
+                    c = getVec<u32>(ifs, spawnCount);
+                    checkIdxs(c, spawnCount);
+                }
+
+                for(const auto& s : bl.spawns)
+                    if(s.cluster < -1 ||
+                        s.cluster >= std::int32_t(clusterCount))
+                        throw std::runtime_error{
+                            "Baked pack index out of bounds"};
+            }
+
+            return result;
+        }
+
+        inline const OBLEBakedLevel* find(int mSector, int mKey) const
+        {
+            auto itr(levels.find({mSector, mKey}));
+            return itr == std::end(levels) ? nullptr : &itr->second;
+        }
+
+        inline SizeT getLevelCount() const noexcept { return levels.size(); }
+    };
+}
+
+#endif
@@ -0,0 +1,719 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_BINARY
+#define SSVOB_LEVELEDITOR_BINARY
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEJson.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEJsonReader.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEMappedFile.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEPack.hpp"
+#include "SSVBloodshed/LevelEditor/OBLESector.hpp"
+#include "SSVBloodshed/LevelEditor/OBLELevel.hpp"
+#include "SSVBloodshed/LevelEditor/OBLETile.hpp"
+
+namespace ob
+{
+    // Binary pack format - every section is an array of fixed-layout
+    // records, so a mapped file can be read in place
+    //
+    //     Header
+    //     StrRec[stringCount]     Offsets into the character blob
+    //     SectorRec[sectorCount]  Each owns a range of levels
+    //     LevelRec[levelCount]    Each owns a range of tiles
+    //     TileRec[tileCount]      Each owns a range of params, and covers
+    //                             `run` identical tiles along its row
+    //     ParamRec[paramCount]    Keys and string values are string indices
+    //     char[]                  Character blob
+    //
+    // Records are stored in host byte order - `byteOrder` rejects files
+    // written on a machine with a different one
+    //
+    // Version 2 elides params equal to their defaults and run-length
+    // encodes tiles - version 1 tiles always have a run of 1
+    //
+    // Levels without tiles are still stored, as records owning no tiles -
+    // their keys are what makes them enterable
+    namespace OBLEBin
+    {
+        using u32 = std::uint32_t;
+        using i32 = std::int32_t;
+
+        constexpr char magic[4]{'O', 'B', 'P', 'K'};
+        constexpr u32 version{2}, minVersion{1};
+        constexpr u32 byteOrder{0x01020304};
+        constexpr SizeT alignment{8};
+
+        struct Header
+        {
+            char magic[4];
+            u32 version, byteOrder, nameStr;
+            u32 stringCount, sectorCount, levelCount, tileCount, paramCount;
+            u32 stringsOffset, sectorsOffset, levelsOffset, tilesOffset,
+                paramsOffset, charsOffset, charsSize;
+        };
+        struct StrRec
+        {
+            u32 offset, size;
+        };
+        struct SectorRec
+        {
+            i32 key, cols, rows;
+            u32 firstLevel, levelCount, pad;
+        };
+        struct LevelRec
+        {
+            i32 key, x, y, cols, rows, depth;
+            u32 firstTile, tileCount;
+        };
+        struct TileRec
+        {
+            i32 key, x, y, z, type;
+            u32 firstParam, paramCount, run;
+        };
+
+        enum class ParamType : u32
+        {
+            Null,
+            IntS,
+            IntU,
+            Real,
+            Bool,
+            Str
+        };
+        struct ParamRec
+        {
+            u32 key;
+            ParamType type;
+            union
+            {
+                std::int64_t intS;
+                std::uint64_t intU;
+                double real;
+                u32 boolean;
+                u32 str;
+            };
+        };
+
+        static_assert(sizeof(TileRec) == 32, "");
+        static_assert(sizeof(ParamRec) == 16, "");
+
+        inline SizeT getAligned(SizeT mOffset) noexcept
+        {
+            return (mOffset + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    // Validated, in-place view over the bytes of a binary pack
+    class OBLEPackView
+    {
+    private:
+        const char* data;
+        SizeT size;
+        const OBLEBin::Header* header;
+        const OBLEBin::StrRec* strings;
+        const OBLEBin::SectorRec* sectors;
+        const OBLEBin::LevelRec* levels;
+        const OBLEBin::TileRec* tiles;
+        const OBLEBin::ParamRec* params;
+        const char* chars;
+
+        template <typename T>
+        inline const T* getSection(OBLEBin::u32 mOffset, OBLEBin::u32 mCount)
+        {
+            if(mOffset % alignof(T) != 0 || mOffset > size ||
+                mCount > (size - mOffset) / sizeof(T))
+                throw std::runtime_error{"Pack section out of bounds"};
+            return reinterpret_cast<const T*>(data + mOffset);
+        }
+
+        inline static void checkRange(
+            OBLEBin::u32 mFirst, OBLEBin::u32 mCount, OBLEBin::u32 mMax)
+        {
+            if(mFirst > mMax || mCount > mMax - mFirst)
+                throw std::runtime_error{"Pack record range out of bounds"};
+        }
+
+    public:
+        inline static bool isBinaryPack(
+            const char* mData, SizeT mSize) noexcept
+        {
+            return mSize >= sizeof(OBLEBin::Header) &&
+                   std::memcmp(mData, OBLEBin::magic, 4) == 0;
+        }
+
+        inline OBLEPackView(const char* mData, SizeT mSize)
+            : data{mData}, size{mSize}
+        {
+            using namespace OBLEBin;
+
+            if(data == nullptr) throw std::runtime_error{"Can't read pack"};
+            if(!isBinaryPack(data, size))
+                throw std::runtime_error{"Not a binary pack"};
+
+            header = reinterpret_cast<const Header*>(data);
+            if(header->version < minVersion || header->version > version)
+                throw std::runtime_error{"Unsupported pack version"};
+            if(header->byteOrder != byteOrder)
+                throw std::runtime_error{"Pack has another byte order"};
+
+            const auto& h(*header);
+            strings = getSection<StrRec>(h.stringsOffset, h.stringCount);
+            sectors = getSection<SectorRec>(h.sectorsOffset, h.sectorCount);
+            levels = getSection<LevelRec>(h.levelsOffset, h.levelCount);
+            tiles = getSection<TileRec>(h.tilesOffset, h.tileCount);
+            params = getSection<ParamRec>(h.paramsOffset, h.paramCount);
+            chars = getSection<char>(h.charsOffset, h.charsSize);
+
+            // Validate the index up front, so that accessors can trust it
+            // afterwards - tiles and params are only validated by
+            // `checkLevel`, once their level is read
+            for(auto i(0u); i < h.stringCount; ++i)
+                checkRange(strings[i].offset, strings[i].size, h.charsSize);
+            for(auto i(0u); i < h.sectorCount; ++i)
+                checkRange(sectors[i].firstLevel,
+                    sectors[i].levelCount, h.levelCount);
+            for(auto i(0u); i < h.levelCount; ++i)
+                checkRange(
+                    levels[i].firstTile, levels[i].tileCount, h.tileCount);
+            if(h.nameStr >= h.stringCount)
+                throw std::runtime_error{"Pack string index out of bounds"};
+        }
+
+        inline void checkLevel(SizeT mIdx) const
+        {
+            using namespace OBLEBin;
+            const auto& h(*header);
+            const auto& l(levels[mIdx]);
+
+            // Bounded sizes also keep the level's tile count from
+            // overflowing
+            if(!OBLELevel::isValidSize(l.cols, l.rows, l.depth))
+                throw std::runtime_error{"Pack level size out of bounds"};
+
+            for(auto i(l.firstTile); i < l.firstTile + l.tileCount; ++i)
+            {
+                const auto& t(tiles[i]);
+                checkRange(t.firstParam, t.paramCount, h.paramCount);
+                if(!isValidTType(t.type))
+                    throw std::runtime_error{"Pack tile type unknown"};
+                if(getRun(t) == 0 || getRun(t) > u32(l.cols))
+                    throw std::runtime_error{"Pack tile run out of bounds"};
+
+                for(auto j(t.firstParam); j < t.firstParam + t.paramCount; ++j)
+                {
+                    const auto& p(params[j]);
+                    if(p.type > ParamType::Str)
+                        throw std::runtime_error{"Pack param type unknown"};
+                    if(p.key >= h.stringCount ||
+                        (p.type == ParamType::Str && p.str >= h.stringCount))
+                        throw std::runtime_error{
+                            "Pack string index out of bounds"};
+                }
+            }
+        }
+
+        inline const OBLEBin::Header& getHeader() const noexcept
+        {
+            return *header;
+        }
+        inline const OBLEBin::SectorRec& getSector(SizeT mIdx) const noexcept
+        {
+            return sectors[mIdx];
+        }
+        inline const OBLEBin::LevelRec& getLevel(SizeT mIdx) const noexcept
+        {
+            return levels[mIdx];
+        }
+        inline const OBLEBin::TileRec& getTile(SizeT mIdx) const noexcept
+        {
+            return tiles[mIdx];
+        }
+        inline OBLEBin::u32 getRun(
+            const OBLEBin::TileRec& mTile) const noexcept
+        {
+            return header->version < 2 ? 1 : mTile.run;
+        }
+        inline const OBLEBin::ParamRec& getParam(SizeT mIdx) const noexcept
+        {
+            return params[mIdx];
+        }
+
+        inline const char* getStrData(SizeT mIdx) const noexcept
+        {
+            return chars + strings[mIdx].offset;
+        }
+        inline SizeT getStrSize(SizeT mIdx) const noexcept
+        {
+            return strings[mIdx].size;
+        }
+        inline std::string getStr(SizeT mIdx) const
+        {
+            return {getStrData(mIdx), getStrSize(mIdx)};
+        }
+    };
+
+    // Binary pack file kept open for as long as a lazily loaded pack still
+    // reads levels from it
+    class OBLEPackFile
+    {
+    private:
+        OBLEMappedFile file;
+        OBLEPackView view;
+
+    public:
+        inline OBLEPackFile(const std::string& mPath)
+            : file{mPath}, view{file.getData(), file.getSize()}
+        {
+        }
+
+        OBLEPackFile(const OBLEPackFile&) = delete;
+        OBLEPackFile& operator=(const OBLEPackFile&) = delete;
+
+        inline const OBLEPackView& getView() const noexcept { return view; }
+    };
+
+    // Conversions between `OBLEPack` and the binary format
+    class OBLEBinary
+    {
+    private:
+        using u32 = OBLEBin::u32;
+
+        class Writer
+        {
+        private:
+            std::map<std::string, u32> stringIdxs;
+            std::vector<OBLEBin::StrRec> strings;
+            std::vector<OBLEBin::SectorRec> sectors;
+            std::vector<OBLEBin::LevelRec> levels;
+            std::vector<OBLEBin::TileRec> tiles;
+            std::vector<OBLEBin::ParamRec> params;
+            std::string chars;
+
+            inline u32 intern(const std::string& mStr)
+            {
+                auto itr(stringIdxs.find(mStr));
+                if(itr != std::end(stringIdxs)) return itr->second;
+
+                strings.push_back({u32(chars.size()), u32(mStr.size())});
+                chars += mStr;
+                return stringIdxs[mStr] = strings.size() - 1;
+            }
+
+            template <typename TMap>
+            inline static auto getSortedKeys(const TMap& mMap)
+            {
+                std::vector<int> result;
+                for(const auto& p : mMap) result.emplace_back(p.first);
+                ssvu::sort(result);
+                return result;
+            }
+
+            inline void addParam(const std::string& mKey, const ssvj::Val& mVal)
+            {
+                using OBLEBin::ParamType;
+
+                OBLEBin::ParamRec p;
+                std::memset(&p, 0, sizeof(p));
+                p.key = intern(mKey);
+
+                if(mVal.is<ssvj::IntS>())
+                {
+                    p.type = ParamType::IntS;
+                    p.intS = mVal.as<ssvj::IntS>();
+                }
+                else if(mVal.is<ssvj::IntU>())
+                {
+                    p.type = ParamType::IntU;
+                    p.intU = mVal.as<ssvj::IntU>();
+                }
+                else if(mVal.is<ssvj::Real>())
+                {
+                    p.type = ParamType::Real;
+                    p.real = mVal.as<ssvj::Real>();
+                }
+                else if(mVal.is<bool>())
+                {
+                    p.type = ParamType::Bool;
+                    p.boolean = mVal.as<bool>();
+                }
+                else if(mVal.is<std::string>())
+                {
+                    p.type = ParamType::Str;
+                    p.str = intern(mVal.as<std::string>());
+                }
+                else
+                {
+                    // Tile params are always scalars
+                    p.type = ParamType::Null;
+                }
+
+                params.emplace_back(p);
+            }
+
+            inline void addTile(const OBLELevel& mLevel, const OBLETile& mTile)
+            {
+                auto firstParam(u32(params.size()));
+                for(const auto& p : getSchema(mTile.getType())
+                                        .toMap(mTile.getParams()))
+                    addParam(p.first, p.second);
+
+                tiles.push_back({ssvu::get1DIdxFrom3D(mTile.getX(),
+                                     mTile.getY(), mTile.getZ(),
+                                     mLevel.getColumns(), mLevel.getRows()),
+                    mTile.getX(), mTile.getY(), mTile.getZ(),
+                    int(mTile.getType()), firstParam,
+                    u32(params.size()) - firstParam, 1});
+            }
+
+            inline static bool isRunOf(
+                const OBLETile& mPrev, const OBLETile& mTile) noexcept
+            {
+                return mTile.getX() == mPrev.getX() + 1 &&
+                       mTile.getY() == mPrev.getY() &&
+                       mTile.getZ() == mPrev.getZ() &&
+                       mTile.getType() == mPrev.getType() &&
+                       mTile.getParams() == mPrev.getParams();
+            }
+
+            // Storage order already matches ascending tile keys, and keeps
+            // the tiles of a row next to each other
+            inline void addLevel(int mKey, const OBLELevel& mLevel)
+            {
+                auto firstTile(u32(tiles.size()));
+                const OBLETile* prev{nullptr};
+                mLevel.forTiles([this, &mLevel, &prev](const OBLETile& mT)
+                    {
+                        if(prev != nullptr && isRunOf(*prev, mT))
+                            ++tiles.back().run;
+                        else
+                            addTile(mLevel, mT);
+
+                        prev = &mT;
+                    });
+                levels.push_back({mKey, mLevel.getX(), mLevel.getY(),
+                    mLevel.getColumns(), mLevel.getRows(), mLevel.getDepth(),
+                    firstTile, u32(tiles.size()) - firstTile});
+            }
+
+            // Levels that aren't resident are read from the pack's file one
+            // at a time
+            inline void addSector(
+                const OBLEPack& mPack, int mKey, const OBLESector& mSector)
+            {
+                auto firstLevel(u32(levels.size()));
+                mPack.forLevels(mSector, [this](int mLKey, const OBLELevel& mL)
+                    {
+                        addLevel(mLKey, mL);
+                    });
+                sectors.push_back({mKey, mSector.getColumns(),
+                    mSector.getRows(), firstLevel,
+                    u32(levels.size()) - firstLevel, 0});
+            }
+
+            template <typename T>
+            inline static void append(std::vector<char>& mOut,
+                const std::vector<T>& mRecords, u32& mOffset)
+            {
+                mOut.resize(OBLEBin::getAligned(mOut.size()));
+                mOffset = mOut.size();
+                auto bytes(reinterpret_cast<const char*>(mRecords.data()));
+                mOut.insert(std::end(mOut), bytes,
+                    bytes + mRecords.size() * sizeof(T));
+            }
+
+        public:
+            inline std::vector<char> write(const OBLEPack& mPack)
+            {
+                OBLEBin::Header h;
+                std::memset(&h, 0, sizeof(h));
+                std::memcpy(h.magic, OBLEBin::magic, 4);
+                h.version = OBLEBin::version;
+                h.byteOrder = OBLEBin::byteOrder;
+                h.nameStr = intern(mPack.getName());
+
+                const auto& pSectors(mPack.getSectors());
+                for(auto k : getSortedKeys(pSectors))
+                    addSector(mPack, k, pSectors.at(k));
+
+                h.stringCount = strings.size();
+                h.sectorCount = sectors.size();
+                h.levelCount = levels.size();
+                h.tileCount = tiles.size();
+                h.paramCount = params.size();
+                h.charsSize = chars.size();
+
+                std::vector<char> result(sizeof(h));
+                append(result, strings, h.stringsOffset);
+                append(result, sectors, h.sectorsOffset);
+                append(result, levels, h.levelsOffset);
+                append(result, tiles, h.tilesOffset);
+                append(result, params, h.paramsOffset);
+                h.charsOffset = result.size();
+                result.insert(std::end(result), std::begin(chars),
+                    std::end(chars));
+
+                std::memcpy(result.data(), &h, sizeof(h));
+                return result;
+            }
+        };
+
+    public:
+        inline static ssvj::Val getParamVal(
+            const OBLEPackView& mView, const OBLEBin::ParamRec& mParam)
+        {
+            using OBLEBin::ParamType;
+
+            switch(mParam.type)
+            {
+                case ParamType::IntS: return ssvj::IntS(mParam.intS);
+                case ParamType::IntU: return ssvj::IntU(mParam.intU);
+                case ParamType::Real: return ssvj::Real(mParam.real);
+                case ParamType::Bool: return mParam.boolean != 0;
+                case ParamType::Str: return mView.getStr(mParam.str);
+                default: return ssvj::Val{};
+            }
+        }
+
+        inline static OBLELevel readLevel(const OBLEPackView& mView,
+            SizeT mIdx, std::vector<std::string>& mErrors)
+        {
+            mView.checkLevel(mIdx);
+            const auto& l(mView.getLevel(mIdx));
+
+            OBLELevel result{l.x, l.y, l.cols, l.rows, l.depth};
+
+            OBLETileData data;
+            for(auto i(l.firstTile); i < l.firstTile + l.tileCount; ++i)
+            {
+                const auto& t(mView.getTile(i));
+                data.x = t.x;
+                data.y = t.y;
+                data.z = t.z;
+                data.type = OBLETType(t.type);
+
+                data.params.clear();
+                for(auto j(t.firstParam); j < t.firstParam + t.paramCount; ++j)
+                {
+                    const auto& p(mView.getParam(j));
+                    data.params[mView.getStr(p.key)] = getParamVal(mView, p);
+                }
+
+                result.set(data, mView.getRun(t), mErrors);
+            }
+
+            return result;
+        }
+        inline static OBLELevel readLevel(
+            const OBLEPackView& mView, SizeT mIdx)
+        {
+            std::vector<std::string> errors;
+            auto result(readLevel(mView, mIdx, errors));
+            OBLELevel::logErrors(errors);
+            return result;
+        }
+
+        // Level records are read on `mWorkers` and then moved into their
+        // sectors - the result, the errors logged and the exception thrown
+        // for an invalid pack are the same as with a serial read
+        inline static OBLEPack read(
+            const OBLEPackView& mView, OBWorkers& mWorkers)
+        {
+            const auto& h(mView.getHeader());
+
+            std::vector<UPtr<OBLELevel>> levels(h.levelCount);
+            std::vector<std::vector<std::string>> errors(h.levelCount);
+            std::vector<std::exception_ptr> failures(h.levelCount);
+            mWorkers.forRanges(h.levelCount, [&](SizeT mBegin, SizeT mEnd)
+                {
+                    for(auto i(mBegin); i < mEnd; ++i)
+                    {
+                        try
+                        {
+                            levels[i] = ssvu::mkUPtr<OBLELevel>(
+                                readLevel(mView, i, errors[i]));
+                        }
+                        catch(...)
+                        {
+                            failures[i] = std::current_exception();
+                        }
+                    }
+                });
+
+            OBLEPack result;
+            result.setName(mView.getStr(h.nameStr));
+
+            for(auto i(0u); i < h.sectorCount; ++i)
+            {
+                const auto& s(mView.getSector(i));
+                auto& sector(result.getSectors()[s.key]);
+                sector = OBLESector{s.cols, s.rows};
+
+                for(auto j(s.firstLevel); j < s.firstLevel + s.levelCount; ++j)
+                {
+                    if(failures[j]) std::rethrow_exception(failures[j]);
+
+                    // Records shared by several sectors are read again
+                    auto level(ssvu::mv(levels[j]));
+                    if(level == nullptr)
+                        level = ssvu::mkUPtr<OBLELevel>(
+                            readLevel(mView, j, errors[j]));
+
+                    OBLELevel::logErrors(errors[j]);
+                    errors[j].clear();
+                    sector.getLevels()[mView.getLevel(j).key] =
+                        ssvu::mv(*level);
+                }
+            }
+
+            return result;
+        }
+        inline static OBLEPack read(const OBLEPackView& mView)
+        {
+            OBWorkers serial{1};
+            return read(mView, serial);
+        }
+
+        // Reads only the pack's index - levels are read on first access
+        inline static OBLEPack open(const std::string& mPath)
+        {
+            auto file(std::make_shared<OBLEPackFile>(mPath));
+            const auto& view(file->getView());
+            const auto& h(view.getHeader());
+
+            OBLEPack result;
+            result.setName(view.getStr(h.nameStr));
+            result.setLoader([file](SizeT mIdx)
+                {
+                    return readLevel(file->getView(), mIdx);
+                });
+
+            for(auto i(0u); i < h.sectorCount; ++i)
+            {
+                const auto& s(view.getSector(i));
+                auto& sector(result.getSectors()[s.key]);
+                sector = OBLESector{s.cols, s.rows};
+
+                for(auto j(s.firstLevel); j < s.firstLevel + s.levelCount; ++j)
+                    sector.addStored(view.getLevel(j).key, j);
+            }
+
+            return result;
+        }
+
+        inline static std::vector<char> write(const OBLEPack& mPack)
+        {
+            return Writer{}.write(mPack);
+        }
+
+        // Writes to a temporary file and then replaces `mPath` with it - a
+        // lazily loaded pack may still have the old file mapped
+        template <typename TF>
+        inline static void replaceFile(const std::string& mPath, const TF& mFn)
+        {
+            auto tmpPath(mPath + ".tmp");
+            mFn(tmpPath);
+
+            if(std::rename(tmpPath.c_str(), mPath.c_str()) == 0) return;
+
+            // Some platforms don't rename over existing files
+            std::remove(mPath.c_str());
+            if(std::rename(tmpPath.c_str(), mPath.c_str()) != 0)
+                throw std::runtime_error{"Can't replace " + mPath};
+        }
+
+        inline static OBLEPack readFromFile(
+            const std::string& mPath, OBWorkers& mWorkers)
+        {
+            OBLEMappedFile file{mPath};
+            if(!file.isOpen()) throw std::runtime_error{"Can't open " + mPath};
+            return read({file.getData(), file.getSize()}, mWorkers);
+        }
+        inline static OBLEPack readFromFile(const std::string& mPath)
+        {
+            OBWorkers serial{1};
+            return readFromFile(mPath, serial);
+        }
+        inline static void writeToFile(
+            const OBLEPack& mPack, const std::string& mPath)
+        {
+            auto bytes(write(mPack));
+            replaceFile(mPath, [&bytes](const std::string& mTmpPath)
+                {
+                    std::ofstream ofs{mTmpPath, std::ios::binary};
+                    ofs.write(bytes.data(), bytes.size());
+                    if(!ofs)
+                        throw std::runtime_error{"Can't write " + mTmpPath};
+                });
+        }
+
+        inline static bool isBinaryPath(const std::string& mPath)
+        {
+            return ssvu::endsWith(mPath, ".obp");
+        }
+        inline static bool isBinaryFile(const std::string& mPath)
+        {
+            char head[4];
+            std::ifstream ifs{mPath, std::ios::binary};
+            return ifs.read(head, 4) &&
+                   std::memcmp(head, OBLEBin::magic, 4) == 0;
+        }
+
+        // Loads a pack of either format, detected from the file's contents -
+        // only its index is read, levels are read on first access
+        inline static OBLEPack loadPack(const std::string& mPath)
+        {
+            if(isBinaryFile(mPath)) return open(mPath);
+            return OBLEJsonReader::open(mPath);
+        }
+
+        // Reads a whole pack of either format, building its levels on
+        // `mWorkers` - for tools that visit every level anyway
+        inline static OBLEPack readPack(
+            const std::string& mPath, OBWorkers& mWorkers)
+        {
+            if(isBinaryFile(mPath)) return readFromFile(mPath, mWorkers);
+            return OBLEJsonReader::readFromFile(mPath, mWorkers);
+        }
+
+        // Saves a pack as binary if `mPath` ends with ".obp", as minified
+        // JSON otherwise
+        inline static void savePack(
+            const OBLEPack& mPack, const std::string& mPath)
+        {
+            if(isBinaryPath(mPath))
+                writeToFile(mPack, mPath);
+            else
+            {
+                ssvj::Val val{toJson(mPack)};
+                replaceFile(mPath, [&val](const std::string& mTmpPath)
+                    {
+                        val.writeToFile<ssvj::WSMinified>(mTmpPath);
+                    });
+            }
+        }
+
+        // JSON <-> binary conversion, in either direction - not lossless:
+        // the pack goes through the editor's typed levels, so params a
+        // tile's schema doesn't know are dropped, values of the wrong type
+        // or out of range are replaced by defaults or clamped (all of them
+        // logged), and params equal to their defaults are elided
+        //
+        // Packs the editor saved convert back and forth unchanged
+        inline static void convert(
+            const std::string& mSrcPath, const std::string& mDstPath)
+        {
+            savePack(loadPack(mSrcPath), mDstPath);
+        }
+    };
+}
+
+#endif
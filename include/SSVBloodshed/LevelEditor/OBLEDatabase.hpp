@@ -7,11 +7,14 @@
 
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBAssets.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEParams.hpp"
+#include "SSVBloodshed/LevelEditor/OBLESpawn.hpp"
 
 namespace ob
 {
-    template <typename TGame, typename TLevel, typename TTile,
-        typename TFactory>
+    // Spawn functions only read baked spawns - wall masks and params are
+    // resolved by `bakeLevel`, offline or when the level is loaded
+    template <typename TGame, typename TFactory>
     class OBLEDatabaseImpl
     {
     public:
@@ -20,27 +23,20 @@ namespace ob
             OBLETType type;
             sf::Texture* texture;
             sf::IntRect intRect;
-            std::map<std::string, ssvj::Val> defaultParams;
-            std::map<std::string, std::string> enumParams;
-            ssvu::Func<void(TLevel&, TTile&, const Vec2i&)> spawn;
+            ssvu::Func<void(const OBLESpawn&, const Vec2i&)> spawn;
 
             inline Entry() = default;
             inline Entry(OBLETType mType, sf::Texture* mTexture,
-                const sf::IntRect& mIntRect,
-                const decltype(defaultParams)& mDefaultParams,
-                decltype(spawn) mSpawn)
+                const sf::IntRect& mIntRect, decltype(spawn) mSpawn)
                 : type{mType}, texture{mTexture}, intRect{mIntRect},
-                  defaultParams{mDefaultParams}, spawn{mSpawn}
+                  spawn{mSpawn}
             {
             }
 
-            inline bool isEnumParam(const std::string& mKey) const
+            // Params are declared by the type's schema
+            inline const OBLESchema& getSchema() const
             {
-                return enumParams.count(mKey) > 0;
-            }
-            inline const std::string& getEnumName(const std::string& mKey) const
-            {
-                return enumParams.at(mKey);
+                return ob::getSchema(type);
             }
         };
 
@@ -50,305 +46,254 @@ namespace ob
         TFactory* f{nullptr};
         std::map<OBLETType, Entry> entries;
 
+        using K = OBLEPKey;
+
         template <typename T>
-        inline T getP(TTile& mT, const std::string& mKey)
+        inline T getP(const OBLESpawn& mS, K mKey)
         {
-            return mT.template getParam<T>(mKey);
+            return mS.params.template get<T>(mKey);
         }
         template <typename T>
-        inline T getPE(TTile& mT, const std::string& mKey)
+        inline T getPE(const OBLESpawn& mS, K mKey)
         {
-            return T(mT.template getParam<int>(mKey));
-        }
-
-        inline int getWallMask(
-            TLevel& mL, OBLETType mType, int mX, int mY, int mZ)
-        {
-            int mask{0}, maxX{mL.getColumns()}, maxY{mL.getRows()};
-
-            auto tileIs = [&mL, maxX, maxY, mZ](
-                int mTX, int mTY, OBLETType mTType)
-            {
-                if(mTX < 0 || mTY < 0 || mTX >= maxX || mTY >= maxY)
-                    return false;
-                return mL.getTile(mTX, mTY, mZ).getType() == mTType;
-            };
-
-            mask += tileIs(mX, mY - 1, mType) << 0;
-            mask += tileIs(mX + 1, mY, mType) << 1;
-            mask += tileIs(mX, mY + 1, mType) << 2;
-            mask += tileIs(mX - 1, mY, mType) << 3;
-            return mask;
+            return T(mS.params.template get<int>(mKey));
         }
 
     public:
         inline OBLEDatabaseImpl(OBAssets& mAssets) : a(mAssets)
         {
-            add(OBLETType::LETFloor, a.txSmall, a.floor, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETFloor, a.txSmall, a.floor,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createFloor(mP, false);
                 });
-            add(OBLETType::LETGrate, a.txSmall, a.floorGrate, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETGrate, a.txSmall, a.floorGrate,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createFloor(mP, true);
                 });
-            add(OBLETType::LETPit, a.txSmall, a.pit, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETPit, a.txSmall, a.pit,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createPit(mP);
                 });
-            add(OBLETType::LETTurretSP, a.txSmall, a.eTurret0, {{"rot", 0}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETTurretSP, a.txSmall, a.eTurret0,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
                     f->createETurretStarPlasma(
-                        mP, getDir8FromDeg(getP<float>(mT, "rot")));
+                        mP, getDir8FromDeg(getP<float>(mS, K::Rot)));
                 });
-            add(OBLETType::LETTurretCP, a.txSmall, a.eTurret1, {{"rot", 0}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETTurretCP, a.txSmall, a.eTurret1,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
                     f->createETurretCannonPlasma(
-                        mP, getDir8FromDeg(getP<float>(mT, "rot")));
+                        mP, getDir8FromDeg(getP<float>(mS, K::Rot)));
                 });
-            add(OBLETType::LETTurretBP, a.txSmall, a.eTurret2, {{"rot", 0}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETTurretBP, a.txSmall, a.eTurret2,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
                     f->createETurretBulletPlasma(
-                        mP, getDir8FromDeg(getP<float>(mT, "rot")));
+                        mP, getDir8FromDeg(getP<float>(mS, K::Rot)));
                 });
-            add(OBLETType::LETTurretRL, a.txSmall, a.eTurret3, {{"rot", 0}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETTurretRL, a.txSmall, a.eTurret3,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
                     f->createETurretRocket(
-                        mP, getDir8FromDeg(getP<float>(mT, "rot")));
+                        mP, getDir8FromDeg(getP<float>(mS, K::Rot)));
                 });
-            add(OBLETType::LETPlayer, a.txSmall, a.p1Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETPlayer, a.txSmall, a.p1Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createPlayer(mP);
                 });
-            add(OBLETType::LETRunner, a.txSmall, a.e1Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETRunner, a.txSmall, a.e1Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createERunner(mP, RunnerType::Unarmed);
                 });
-            add(OBLETType::LETRunnerArmed, a.txSmall, a.e1Shoot, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETRunnerArmed, a.txSmall, a.e1Shoot,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createERunner(mP, RunnerType::PlasmaBolter);
                 });
-            add(OBLETType::LETCharger, a.txMedium, a.e2Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETCharger, a.txMedium, a.e2Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createECharger(mP, ChargerType::Unarmed);
                 });
-            add(OBLETType::LETChargerArmed, a.txMedium, a.e2Shoot, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETChargerArmed, a.txMedium, a.e2Shoot,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createECharger(mP, ChargerType::PlasmaBolter);
                 });
-            add(OBLETType::LETJuggernaut, a.txBig, a.e3Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETJuggernaut, a.txBig, a.e3Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEJuggernaut(mP, JuggernautType::Unarmed);
                 });
-            add(OBLETType::LETJuggernautArmed, a.txBig, a.e3Shoot, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETJuggernautArmed, a.txBig, a.e3Shoot,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEJuggernaut(mP, JuggernautType::PlasmaBolter);
                 });
-            add(OBLETType::LETGiant, a.txGiant, a.e4Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETGiant, a.txGiant, a.e4Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEGiant(mP);
                 });
-            add(OBLETType::LETBall, a.txSmall, a.eBall, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETBall, a.txSmall, a.eBall,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEBall(mP, BallType::Normal, false);
                 });
-            add(OBLETType::LETBallFlying, a.txSmall, a.eBallFlying, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETBallFlying, a.txSmall, a.eBallFlying,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEBall(mP, BallType::Flying, false);
                 });
-            add(OBLETType::LETEnforcer, a.txMedium, a.e5Stand, {{"rot", 0}},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETEnforcer, a.txMedium, a.e5Stand,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createEEnforcer(mP);
                 });
-            add(OBLETType::LETTrapdoor, a.txSmall, a.trapdoor, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETTrapdoor, a.txSmall, a.trapdoor,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createTrapdoor(mP, false);
                 });
-            add(OBLETType::LETTrapdoorPOnly, a.txSmall, a.trapdoorPOnly, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETTrapdoorPOnly, a.txSmall, a.trapdoorPOnly,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createTrapdoor(mP, true);
                 });
             add(OBLETType::LETExplosiveCrate, a.txSmall, a.explosiveCrate,
-                {{"id", -1}}, [this](TLevel&, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
                     f->createFloor(mP, true);
-                    f->createExplosiveCrate(mP, getP<int>(mT, "id"));
+                    f->createExplosiveCrate(mP, getP<int>(mS, K::Id));
                 });
-            add(OBLETType::LETVMHealth, a.txSmall, a.vmHealth, {},
-                [this](TLevel&, TTile&, const Vec2i& mP)
+            add(OBLETType::LETVMHealth, a.txSmall, a.vmHealth,
+                [this](const OBLESpawn&, const Vec2i& mP)
                 {
                     f->createVMHealth(mP);
                 });
 
-            add(OBLETType::LETWall, a.txSmall, a.wallSingle, {},
-                [this](TLevel& mL, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETWall, a.txSmall, a.wallSingle,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    int mask{getWallMask(mL, OBLETType::LETWall, mT.getX(),
-                        mT.getY(), mT.getZ())};
-                    f->createWall(mP, *a.wallBitMask[mask]);
+                    f->createWall(mP, *a.wallBitMask[mS.mask]);
                 });
 
-            add(OBLETType::LETWallD, a.txSmall, a.wallDSingle, {},
-                [this](TLevel& mL, TTile& mT, const Vec2i& mP)
+            add(OBLETType::LETWallD, a.txSmall, a.wallDSingle,
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    int mask{getWallMask(mL, OBLETType::LETWallD, mT.getX(),
-                        mT.getY(), mT.getZ())};
                     f->createFloor(mP, true);
-                    f->createWallDestructible(mP, *a.wallDBitMask[mask]);
+                    f->createWallDestructible(
+                        mP, *a.wallDBitMask[mS.mask]);
                 });
 
             add(OBLETType::LETDoor, a.txSmall, a.doorSingle,
-                {{"id", 0}, {"open", false}},
-                [this](TLevel& mL, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    int mask{getWallMask(mL, OBLETType::LETDoor, mT.getX(),
-                        mT.getY(), mT.getZ())};
                     f->createFloor(mP, true);
-                    f->createDoor(mP, *a.doorBitMask[mask], getP<int>(mT, "id"),
-                        getP<bool>(mT, "open"));
+                    f->createDoor(mP, *a.doorBitMask[mS.mask],
+                        getP<int>(mS, K::Id), getP<bool>(mS, K::Open));
                 });
 
             add(OBLETType::LETDoorG, a.txSmall, a.doorGSingle,
-                {{"open", false}},
-                [this](TLevel& mL, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    int mask{getWallMask(mL, OBLETType::LETDoorG, mT.getX(),
-                        mT.getY(), mT.getZ())};
                     f->createFloor(mP, true);
-                    f->createDoorG(
-                        mP, *a.doorGBitMask[mask], getP<bool>(mT, "open"));
+                    f->createDoorG(mP, *a.doorGBitMask[mS.mask],
+                        getP<bool>(mS, K::Open));
                 });
 
             add(OBLETType::LETDoorR, a.txSmall, a.doorRSingle,
-                {{"open", false}},
-                [this](TLevel& mL, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    int mask{getWallMask(mL, OBLETType::LETDoorR, mT.getX(),
-                        mT.getY(), mT.getZ())};
                     f->createFloor(mP, true);
-                    f->createDoorR(
-                        mP, *a.doorRBitMask[mask], getP<bool>(mT, "open"));
+                    f->createDoorR(mP, *a.doorRBitMask[mS.mask],
+                        getP<bool>(mS, K::Open));
                 });
 
             add(OBLETType::LETSpawner, a.txSmall, a.spawner,
-                {{"id", -1}, {"enemyType", 0}, {"delayStart", 0.f},
-                    {"delaySpawn", 200.f}, {"spawnCount", 1}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
-                {
-                    f->createSpawner(mP, getPE<SpawnerItem>(mT, "enemyType"),
-                        getP<int>(mT, "id"), getP<float>(mT, "delayStart"),
-                        getP<float>(mT, "delaySpawn"),
-                        getP<int>(mT, "spawnCount"));
-                },
-                {{"enemyType", "SpawnerItem"}});
+                [this](const OBLESpawn& mS, const Vec2i& mP)
+                {
+                    f->createSpawner(mP, getPE<SpawnerItem>(mS, K::EnemyType),
+                        getP<int>(mS, K::Id), getP<float>(mS, K::DelayStart),
+                        getP<float>(mS, K::DelaySpawn),
+                        getP<int>(mS, K::SpawnCount));
+                });
 
             add(OBLETType::LETPPlateSingle, a.txSmall, a.pPlateSingle,
-                {{"id", 0}, {"action", 0}, {"playerOnly", false}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
-                {
-                    f->createPPlate(mP, getP<int>(mT, "id"), PPlateType::Single,
-                        getPE<IdAction>(mT, "action"),
-                        getP<bool>(mT, "playerOnly"));
-                },
-                {{"action", "IdAction"}});
+                [this](const OBLESpawn& mS, const Vec2i& mP)
+                {
+                    f->createPPlate(mP, getP<int>(mS, K::Id),
+                        PPlateType::Single, getPE<IdAction>(mS, K::Action),
+                        getP<bool>(mS, K::PlayerOnly), mS.cluster);
+                });
 
             add(OBLETType::LETPPlateMulti, a.txSmall, a.pPlateMulti,
-                {{"id", 0}, {"action", 0}, {"playerOnly", false}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
-                {
-                    f->createPPlate(mP, getP<int>(mT, "id"), PPlateType::Multi,
-                        getPE<IdAction>(mT, "action"),
-                        getP<bool>(mT, "playerOnly"));
-                },
-                {{"action", "IdAction"}});
+                [this](const OBLESpawn& mS, const Vec2i& mP)
+                {
+                    f->createPPlate(mP, getP<int>(mS, K::Id),
+                        PPlateType::Multi, getPE<IdAction>(mS, K::Action),
+                        getP<bool>(mS, K::PlayerOnly), mS.cluster);
+                });
 
             add(OBLETType::LETPPlateOnOff, a.txSmall, a.pPlateOnOff,
-                {{"id", 0}, {"action", 0}, {"playerOnly", false}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
-                {
-                    f->createPPlate(mP, getP<int>(mT, "id"), PPlateType::OnOff,
-                        getPE<IdAction>(mT, "action"),
-                        getP<bool>(mT, "playerOnly"));
-                },
-                {{"action", "IdAction"}});
+                [this](const OBLESpawn& mS, const Vec2i& mP)
+                {
+                    f->createPPlate(mP, getP<int>(mS, K::Id),
+                        PPlateType::OnOff, getPE<IdAction>(mS, K::Action),
+                        getP<bool>(mS, K::PlayerOnly), mS.cluster);
+                });
 
             add(OBLETType::LETForceField, a.txSmall, a.ff0,
-                {{"id", 0}, {"rot", 0}, {"blockFriendly", true},
-                    {"blockEnemy", true}, {"forceMult", 100.f}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    f->createForceField(mP, getP<int>(mT, "id"),
-                        getDir8FromDeg(getP<float>(mT, "rot")),
-                        getP<bool>(mT, "blockFriendly"),
-                        getP<bool>(mT, "blockEnemy"),
-                        getP<float>(mT, "forceMult") / 100.f);
+                    f->createForceField(mP, getP<int>(mS, K::Id),
+                        getDir8FromDeg(getP<float>(mS, K::Rot)),
+                        getP<bool>(mS, K::BlockFriendly),
+                        getP<bool>(mS, K::BlockEnemy),
+                        getP<float>(mS, K::ForceMult) / 100.f);
                 });
 
             add(OBLETType::LETBulletForceField, a.txSmall, a.forceArrowMark,
-                {{"id", 0}, {"rot", 0}, {"blockFriendly", true},
-                    {"blockEnemy", true}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    f->createBulletForceField(mP, getP<int>(mT, "id"),
-                        getDir8FromDeg(getP<float>(mT, "rot")),
-                        getP<bool>(mT, "blockFriendly"),
-                        getP<bool>(mT, "blockEnemy"));
+                    f->createBulletForceField(mP, getP<int>(mS, K::Id),
+                        getDir8FromDeg(getP<float>(mS, K::Rot)),
+                        getP<bool>(mS, K::BlockFriendly),
+                        getP<bool>(mS, K::BlockEnemy));
                 });
 
             add(OBLETType::LETPjBooster, a.txSmall, a.fpj0,
-                {{"id", 0}, {"rot", 0}, {"forceMult", 100.f}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    f->createBooster(mP, getP<int>(mT, "id"),
-                        getDir8FromDeg(getP<float>(mT, "rot")),
-                        getP<float>(mT, "forceMult") / 100.f);
+                    f->createBooster(mP, getP<int>(mS, K::Id),
+                        getDir8FromDeg(getP<float>(mS, K::Rot)),
+                        getP<float>(mS, K::ForceMult) / 100.f);
                 });
 
             add(OBLETType::LETPjChanger, a.txSmall, a.bulletChanger,
-                {{"id", 0}, {"rot", 0}},
-                [this](TLevel&, TTile& mT, const Vec2i& mP)
+                [this](const OBLESpawn& mS, const Vec2i& mP)
                 {
-                    f->createBooster(mP, getP<int>(mT, "id"),
-                        getDir8FromDeg(getP<float>(mT, "rot")), 0.f);
+                    f->createBooster(mP, getP<int>(mS, K::Id),
+                        getDir8FromDeg(getP<float>(mS, K::Rot)), 0.f);
                 });
         }
 
         template <typename T>
         inline void add(OBLETType mType, sf::Texture* mTexture,
-            const sf::IntRect& mIntRect,
-            const std::map<std::string, ssvj::Val>& mDefaultParams,
-            const T& mSpawn,
-            const std::initializer_list<std::pair<std::string, std::string>>&
-                mEnumParams = {})
+            const sf::IntRect& mIntRect, const T& mSpawn)
         {
-            entries[mType] =
-                Entry{mType, mTexture, mIntRect, mDefaultParams, mSpawn};
-            for(auto& p : mEnumParams) entries[mType].enumParams.insert(p);
+            entries[mType] = Entry{mType, mTexture, mIntRect, mSpawn};
         }
-        inline void spawn(TLevel& mLevel, TTile& mTile, const Vec2i& mPos)
+        inline void spawn(const OBLESpawn& mSpawn, const Vec2i& mPos)
         {
-            if(mTile.getType() == OBLETType::LETNull) return;
-            get(mTile.getType()).spawn(mLevel, mTile, mPos);
+            if(mSpawn.type == OBLETType::LETNull) return;
+            get(mSpawn.type).spawn(mSpawn, mPos);
         }
 
         inline const Entry& get(OBLETType mType) const
@@ -367,11 +312,8 @@ namespace ob
     // Template magic to temporarily avoid creating .cpp source files
     class OBGame;
     class OBFactory;
-    class OBLELevel;
-    class OBLETile;
 
-    using OBLEDatabase =
-        OBLEDatabaseImpl<OBGame, OBLELevel, OBLETile, OBFactory>;
+    using OBLEDatabase = OBLEDatabaseImpl<OBGame, OBFactory>;
     using OBLEDatabaseEntry = OBLEDatabase::Entry;
 }
 
@@ -55,7 +55,8 @@ namespace ob
         std::pair<OBLETType, std::map<std::string, ssvj::Val>> copiedParams{
             OBLETType::LETFloor, {}};
 
-        OBLETileData copiedTile;
+        OBLETType copiedType{OBLETType::LETNull};
+        OBLEParams copiedParams;
 
         GUI::Context guiCtx;
 
@@ -195,12 +196,14 @@ namespace ob
         inline void loadLevel(int mX, int mY)
         {
             sharedData.setCurrentLevel(mX, mY);
-            for(auto& t : sharedData.getCurrentTiles())
-                if(t.second.hasParam("id")) t.second.refreshIdText(assets);
+            sharedData.getCurrentLevel().forTiles([this](OBLETile& mT)
+                {
+                    mT.refreshIdText(assets);
+                });
         }
         inline void clearCurrentSector()
         {
-            sharedData.getCurrentSector().clear();
+            sharedData.clearCurrentSector();
             loadLevel(0, 0);
         }
         inline void clearCurrentLevel()
@@ -223,46 +226,53 @@ namespace ob
                                 iX, iY, currentZ));
         }
 
-        inline OBLETile& getPickTile() const noexcept
+        inline OBLETile* getPickTile() const noexcept
         {
-            return sharedData.getCurrentLevel().getTile(
+            if(!sharedData.isTileValid(brush.getX(), brush.getY(), currentZ))
+                return nullptr;
+            return &sharedData.getCurrentLevel().getTile(
                 brush.getX(), brush.getY(), currentZ);
         }
 
         inline void paint()
         {
+            auto& level(sharedData.getCurrentLevel());
             for(auto& t : currentTiles)
             {
-                t->initFromEntry(getCurrentEntry());
+                level.init(*t, getCurrentEntry());
                 t->setRot(currentRot);
                 t->setId(assets, currentId);
             }
         }
         inline void del()
         {
-            for(auto& t : currentTiles)
-            {
-                sharedData.getCurrentLevel().del(*t);
-            }
+            for(auto& t : currentTiles) sharedData.getCurrentLevel().del(*t);
         }
         inline void pick()
         {
-            const auto& type(int(getPickTile().getType()));
-            if(type != -1) brush.setIdx(type);
+            auto t(getPickTile());
+            if(t != nullptr && !t->isNull()) brush.setIdx(int(t->getType()));
+        }
+        inline void openParams()
+        {
+            auto t(getPickTile());
+            if(t != nullptr) createFormParams(*t);
         }
-        inline void openParams() { createFormParams(getPickTile()); }
 
         inline void copyTiles()
         {
-            auto& t(getPickTile());
-            copiedTile = t.getData();
+            auto t(getPickTile());
+            if(t == nullptr) return;
+
+            copiedType = t->getType();
+            copiedParams = t->getParams();
         }
         inline void pasteTiles()
         {
+            auto& level(sharedData.getCurrentLevel());
             for(auto& t : currentTiles)
             {
-                t->initFromEntry(sharedData.getDatabase().get(copiedTile.type));
-                t->setParams(copiedTile.params);
+                level.set(*t, copiedType, copiedParams);
                 t->refreshIdText(assets);
             }
         }
@@ -297,16 +307,6 @@ namespace ob
 
             if(!sharedData.isCurrentLevelNull())
             {
-                for(auto& p : sharedData.getCurrentTiles())
-                {
-                    auto& tile(p.second);
-
-                    if(tile.getType() != OBLETType::LETNull)
-                        tile.initGfxFromEntry(sharedData.getDatabase().get(
-                            OBLETType(tile.getType())));
-                }
-
-                sharedData.getCurrentLevel().update();
                 grabTiles();
 
                 if(!guiCtx.isInUse())
@@ -329,7 +329,8 @@ namespace ob
             {
                 if(!sharedData.isCurrentLevelNull())
                     sharedData.getCurrentLevel().draw(gameWindow,
-                        chbOnion->getState(), chbShowId->getState(), currentZ);
+                        sharedData.getDatabase(), chbOnion->getState(),
+                        chbShowId->getState(), currentZ);
                 render(brush);
             }
             gameCamera.unapply();
@@ -348,7 +349,7 @@ namespace ob
                         10.f / s.getTextureRect().height);
                     s.setOrigin(origin);
                     s.setPosition(20 + (12 * i), 230);
-                    if(e.defaultParams.count("rot") > 0)
+                    if(e.getSchema().find(OBLEPKey::Rot) != nullptr)
                         s.setRotation(currentRot);
                     render(s);
                 }
@@ -456,9 +457,17 @@ namespace ob
         GUI::Strip& mainStrip;
         OBLETType prevType{OBLETType::LETFloor};
 
-        std::map<std::string, GUI::CheckBox*> checkBoxes;
-        std::map<std::string, GUI::TextBox*> textBoxes;
-        std::map<std::string, GUI::ChoiceShutter*> enumChoiceShutters;
+        std::map<OBLEPKey, GUI::CheckBox*> checkBoxes;
+        std::map<OBLEPKey, GUI::TextBox*> textBoxes;
+        std::map<OBLEPKey, GUI::ChoiceShutter*> enumChoiceShutters;
+
+        inline static std::string getParamStr(
+            const OBLETile& mTile, OBLEPKey mKey)
+        {
+            if(getPKeyInfo(mKey).type == OBLEPType::Int)
+                return ssvu::toStr(mTile.getParam<int>(mKey));
+            return ssvu::toStr(mTile.getParam<float>(mKey));
+        }
 
         inline OBLETile* getTile()
         {
@@ -493,22 +502,7 @@ namespace ob
                 for(auto& p : textBoxes)
                 {
                     if(p.second->isFocused()) continue;
-
-                    if(tile->getParams()[p.first].is<std::string>())
-                    {
-                        p.second->setString(
-                            tile->getParam<std::string>(p.first));
-                    }
-                    else if(tile->getParams()[p.first].is<ssvj::IntS>())
-                    {
-                        p.second->setString(
-                            ssvu::toStr(tile->getParam<int>(p.first)));
-                    }
-                    else if(tile->getParams()[p.first].is<ssvj::Real>())
-                    {
-                        p.second->setString(
-                            ssvu::toStr(tile->getParam<float>(p.first)));
-                    }
+                    p.second->setString(getParamStr(*tile, p.first));
                 }
                 for(auto& p : enumChoiceShutters)
                 {
@@ -533,24 +527,23 @@ namespace ob
             // Set the previous type to the current type
             prevType = tile->getType();
 
-            // And build an interface for the tile's parameters
-            for(auto& p : tile->getParams())
+            // And build an interface for the tile's parameters, in the
+            // order its schema declares them
+            for(const auto& d : getSchema(tile->getType()).getDefs())
             {
-                auto key(p.first);
+                auto key(d.key);
+                const auto& info(getPKeyInfo(key));
 
                 GUI::Strip& strip(mainStrip.create<GUI::Strip>(
                     GUI::At::Left, GUI::At::Right, GUI::At::Right));
-                strip.create<GUI::Label>(key);
+                strip.create<GUI::Label>(info.name);
                 strip.setTabSize(100.f);
 
-                const auto& entry(
-                    editor.sharedData.getDatabase().get(tile->getType()));
-
-                if(entry.isEnumParam(key))
+                if(info.enumName != nullptr)
                 {
                     // Enum parameters
                     auto& choiceShutter(strip.create<GUI::ChoiceShutter>(
-                        getEnumStrVecByName(entry.getEnumName(key)),
+                        getEnumStrVecByName(info.enumName),
                         getStyle().getBtnSizePerChar(7)));
                     choiceShutter.onChoiceSelected +=
                         [key, tile, &choiceShutter]
@@ -566,10 +559,10 @@ namespace ob
                 else
                 {
                     // Generic parameters (bool, textbox)
-                    if(p.second.is<bool>())
+                    if(info.type == OBLEPType::Bool)
                     {
                         auto& checkBox(strip.create<GUI::CheckBox>(
-                            "on", p.second.as<bool>()));
+                            "on", tile->getParam<bool>(key)));
                         checkBox.onStateChanged += [key, tile, &checkBox]
                         {
                             tile->setParam(
@@ -581,15 +574,7 @@ namespace ob
                     {
                         auto& textBox(strip.create<GUI::TextBox>(
                             getStyle().getBtnSizePerChar(7)));
-                        auto str(ssvu::toStr(p.second));
-
-                        {
-                            auto i(str.size());
-                            while(i > 0 && str[i - 1] == '\n') --i;
-                            str.erase(i, str.size());
-                        }
-
-                        textBox.setString(str);
+                        textBox.setString(getParamStr(*tile, key));
                         textBox.onTextChanged += [this, key, tile, &textBox]
                         {
                             tile->setParam(key, textBox.getString());
@@ -11,11 +11,62 @@
 #include "SSVBloodshed/LevelEditor/OBLELevel.hpp"
 #include "SSVBloodshed/LevelEditor/OBLETile.hpp"
 
-SSVJ_CNV_VAL(ob::OBLETile, data)
-SSVJ_CNV_VAL(ob::OBLESector, levels)
+namespace ob
+{
+    // Plain mirrors of the pack structures in the JSON pack layout - levels
+    // store their tiles densely, so they're converted through these when
+    // saving (`OBLEJsonReader` loads packs without them)
+    //
+    // Params equal to their defaults aren't written - levels without tiles
+    // are, as their keys are what makes them enterable
+    struct OBLEJsonLevel
+    {
+        int x{0}, y{0}, cols{levelCols}, rows{levelRows}, depth{5};
+        std::unordered_map<int, OBLETileData> tiles;
+    };
+
+    struct OBLEJsonSector
+    {
+        std::unordered_map<int, OBLEJsonLevel> levels;
+    };
+
+    struct OBLEJsonPack
+    {
+        std::string name;
+        std::unordered_map<int, OBLEJsonSector> sectors;
+    };
+
+    inline OBLEJsonPack toJson(const OBLEPack& mPack)
+    {
+        OBLEJsonPack result;
+        result.name = mPack.getName();
+
+        for(const auto& s : mPack.getSectors())
+        {
+            auto& levels(result.sectors[s.first].levels);
+            mPack.forLevels(s.second, [&levels](int mKey, const OBLELevel& mL)
+                {
+                    auto& jl(levels[mKey]);
+                    jl = {mL.getX(), mL.getY(), mL.getColumns(), mL.getRows(),
+                        mL.getDepth(), {}};
+
+                    mL.forTiles([&jl, &mL](const OBLETile& mT)
+                        {
+                            jl.tiles[ssvu::get1DIdxFrom3D(mT.getX(),
+                                mT.getY(), mT.getZ(), mL.getColumns(),
+                                mL.getRows())] = mT.getCompactData();
+                        });
+                });
+        }
+
+        return result;
+    }
+}
+
+SSVJ_CNV_VAL(ob::OBLEJsonSector, levels)
 
 SSVJ_CNV_ARR(ob::OBLETileData, x, y, z, type, params)
-SSVJ_CNV_ARR(ob::OBLELevel, x, y, cols, rows, depth, tiles)
-SSVJ_CNV_ARR(ob::OBLEPack, name, sectors)
+SSVJ_CNV_ARR(ob::OBLEJsonLevel, x, y, cols, rows, depth, tiles)
+SSVJ_CNV_ARR(ob::OBLEJsonPack, name, sectors)
 
 #endif
@@ -0,0 +1,561 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_JSONREADER
+#define SSVOB_LEVELEDITOR_JSONREADER
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEPack.hpp"
+#include "SSVBloodshed/LevelEditor/OBLESector.hpp"
+#include "SSVBloodshed/LevelEditor/OBLELevel.hpp"
+#include "SSVBloodshed/LevelEditor/OBLETile.hpp"
+
+namespace ob
+{
+    // Pull tokenizer over a stream of JSON text - it never holds more than
+    // the token being read, and errors carry the position of the token that
+    // caused them
+    class OBLEJsonLexer
+    {
+    public:
+        // Where a token starts - lexing can resume from one, as long as the
+        // stream is positioned at its byte
+        struct Pos
+        {
+            SizeT line, column, offset;
+        };
+
+    private:
+        using Traits = std::char_traits<char>;
+
+        std::streambuf& buf;
+        SizeT line{1}, column{1}, offset{0};
+        SizeT tokLine{1}, tokColumn{1}, tokOffset{0};
+
+        inline int peekRaw() { return buf.sgetc(); }
+        inline int getRaw()
+        {
+            auto c(buf.sbumpc());
+            if(c == Traits::eof()) return c;
+
+            ++offset;
+            if(c == '\n')
+            {
+                ++line;
+                column = 1;
+            }
+            else
+                ++column;
+
+            return c;
+        }
+
+        inline static std::string describe(int mC)
+        {
+            if(mC == Traits::eof()) return "end of input";
+            if(mC < 0x20 || mC >= 0x7f)
+                return "byte " + ssvu::toStr(mC & 0xff);
+            return "'" + std::string(1, char(mC)) + "'";
+        }
+
+        inline static void appendUtf8(std::string& mOut, unsigned int mCP)
+        {
+            if(mCP < 0x80)
+                mOut += char(mCP);
+            else if(mCP < 0x800)
+            {
+                mOut += char(0xc0 | (mCP >> 6));
+                mOut += char(0x80 | (mCP & 0x3f));
+            }
+            else
+            {
+                mOut += char(0xe0 | (mCP >> 12));
+                mOut += char(0x80 | ((mCP >> 6) & 0x3f));
+                mOut += char(0x80 | (mCP & 0x3f));
+            }
+        }
+
+        inline unsigned int readHex4()
+        {
+            unsigned int result{0};
+            for(auto i(0); i < 4; ++i)
+            {
+                auto c(getRaw());
+                result <<= 4;
+
+                if(c >= '0' && c <= '9')
+                    result |= c - '0';
+                else if(c >= 'a' && c <= 'f')
+                    result |= c - 'a' + 10;
+                else if(c >= 'A' && c <= 'F')
+                    result |= c - 'A' + 10;
+                else
+                    fail("invalid \\u escape, found " + describe(c));
+            }
+            return result;
+        }
+
+    public:
+        inline OBLEJsonLexer(std::streambuf& mBuf) : buf(mBuf) {}
+        inline OBLEJsonLexer(std::streambuf& mBuf, const Pos& mPos)
+            : buf(mBuf), line{mPos.line}, column{mPos.column},
+              offset{mPos.offset}
+        {
+        }
+
+        // Position of the token last peeked at
+        inline Pos getPos() const noexcept
+        {
+            return {tokLine, tokColumn, tokOffset};
+        }
+
+        [[noreturn]] inline void fail(const std::string& mMsg) const
+        {
+            throw std::runtime_error{"Pack parse error at line " +
+                                     ssvu::toStr(tokLine) + ", column " +
+                                     ssvu::toStr(tokColumn) + " (byte " +
+                                     ssvu::toStr(tokOffset) + "): " + mMsg};
+        }
+
+        // Skips whitespace and marks the start of the next token
+        inline int peek()
+        {
+            auto c(peekRaw());
+            while(c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            {
+                getRaw();
+                c = peekRaw();
+            }
+
+            tokLine = line;
+            tokColumn = column;
+            tokOffset = offset;
+            return c;
+        }
+
+        inline bool accept(char mC)
+        {
+            if(peek() != mC) return false;
+            getRaw();
+            return true;
+        }
+        inline void expect(char mC)
+        {
+            auto c(peek());
+            if(c != mC)
+                fail("expected '" + std::string(1, mC) + "', found " +
+                     describe(c));
+            getRaw();
+        }
+        inline void expectWord(const std::string& mWord)
+        {
+            auto c(peek());
+            for(auto wc : mWord)
+                if(getRaw() != wc)
+                    fail("expected " + mWord + ", found " + describe(c));
+        }
+        inline void expectEnd()
+        {
+            auto c(peek());
+            if(c != Traits::eof())
+                fail("expected end of input, found " + describe(c));
+        }
+
+        inline std::string readStr()
+        {
+            expect('"');
+
+            std::string result;
+            while(true)
+            {
+                auto c(getRaw());
+                if(c == '"') return result;
+                if(c == Traits::eof()) fail("unterminated string");
+                if(c < 0x20 && c >= 0) fail("control character in string");
+                if(c != '\\')
+                {
+                    result += char(c);
+                    continue;
+                }
+
+                c = getRaw();
+                switch(c)
+                {
+                    case '"': result += '"'; break;
+                    case '\\': result += '\\'; break;
+                    case '/': result += '/'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': appendUtf8(result, readHex4()); break;
+                    default: fail("invalid escape " + describe(c));
+                }
+            }
+        }
+
+        // Reads a number - returns false and sets `mReal` if it has a
+        // fraction or an exponent, returns true and sets `mInt` otherwise
+        inline bool readNumber(long long& mInt, double& mReal)
+        {
+            auto c(peek());
+            if(c != '-' && (c < '0' || c > '9'))
+                fail("expected a number, found " + describe(c));
+
+            std::string str;
+            bool integral{true};
+            for(c = peekRaw(); (c >= '0' && c <= '9') || c == '-' ||
+                               c == '+' || c == '.' || c == 'e' || c == 'E';
+                c = peekRaw())
+            {
+                if(c == '.' || c == 'e' || c == 'E') integral = false;
+                str += char(getRaw());
+            }
+
+            char* end;
+            errno = 0;
+            if(integral)
+                mInt = std::strtoll(str.c_str(), &end, 10);
+            else
+                mReal = std::strtod(str.c_str(), &end);
+
+            if(*end != '\0' || str == "-")
+                fail("invalid number <" + str + ">");
+            if(errno == ERANGE) fail("number <" + str + "> out of range");
+            return integral;
+        }
+
+        inline int readInt()
+        {
+            long long i;
+            double r;
+            if(!readNumber(i, r)) fail("expected an integer");
+            if(i < INT_MIN || i > INT_MAX) fail("integer out of range");
+            return int(i);
+        }
+
+        inline bool readBool()
+        {
+            if(peek() != 't')
+            {
+                expectWord("false");
+                return false;
+            }
+
+            expectWord("true");
+            return true;
+        }
+
+        // Skips a list or a scalar without building it
+        inline void skipValue()
+        {
+            auto c(peek());
+            if(c == '"')
+                readStr();
+            else if(c == 't' || c == 'f')
+                readBool();
+            else if(c == 'n')
+                expectWord("null");
+            else if(c != '[')
+            {
+                long long i;
+                double r;
+                readNumber(i, r);
+            }
+            else
+            {
+                getRaw();
+                if(accept(']')) return;
+
+                do
+                    skipValue();
+                while(accept(','));
+                expect(']');
+            }
+        }
+    };
+
+    // Reads a JSON pack straight from its text, building levels as their
+    // tiles are read - no DOM of the whole pack is ever built
+    //
+    // Tiles are buffered one batch of levels at a time, so that the levels
+    // can be built on `mWorkers` while the reader stays bounded in memory
+    // - levels are merged and errors logged in the same order as a serial
+    // read
+    //
+    // `open` only indexes the pack instead: level bodies are skipped, and
+    // read from their recorded position on first access
+    class OBLEJsonReader
+    {
+    private:
+        struct Pending
+        {
+            int sector, key, x, y, cols, rows, depth;
+            std::vector<OBLETileData> tiles;
+        };
+
+        OBLEJsonLexer lex;
+        OBWorkers& workers;
+        OBLEPack result;
+        std::vector<Pending> pending;
+
+        // Reads `[item, item, ...]` - ssvj writes empty lists as `null`
+        template <typename TF>
+        inline void readList(const TF& mFn)
+        {
+            if(lex.peek() == 'n')
+            {
+                lex.expectWord("null");
+                return;
+            }
+
+            lex.expect('[');
+            if(lex.accept(']')) return;
+
+            do
+                mFn();
+            while(lex.accept(','));
+            lex.expect(']');
+        }
+
+        // Reads `[[key, value], ...]`, the layout of maps with int keys
+        template <typename TF>
+        inline void readPairs(const TF& mFn)
+        {
+            readList([this, &mFn]
+                {
+                    lex.expect('[');
+                    auto key(lex.readInt());
+                    lex.expect(',');
+                    mFn(key);
+                    lex.expect(']');
+                });
+        }
+
+        inline ssvj::Val readScalar()
+        {
+            auto c(lex.peek());
+            if(c == '"') return lex.readStr();
+            if(c == 't' || c == 'f') return lex.readBool();
+
+            long long i;
+            double r;
+            if(lex.readNumber(i, r)) return ssvj::IntS(i);
+            return ssvj::Real(r);
+        }
+
+        inline void readTile(OBLETileData& mData)
+        {
+            lex.expect('[');
+            mData.x = lex.readInt();
+            lex.expect(',');
+            mData.y = lex.readInt();
+            lex.expect(',');
+            mData.z = lex.readInt();
+            lex.expect(',');
+            auto type(lex.readInt());
+            if(!isValidTType(type))
+                lex.fail("unknown tile type " + ssvu::toStr(type));
+            mData.type = OBLETType(type);
+            lex.expect(',');
+
+            readList([this, &mData]
+                {
+                    lex.expect('[');
+                    auto key(lex.readStr());
+                    lex.expect(',');
+                    mData.params[key] = readScalar();
+                    lex.expect(']');
+                });
+            lex.expect(']');
+        }
+
+        inline void readLevelBody(Pending& mP)
+        {
+            auto readDim([this](int mMax, const std::string& mWhat)
+                {
+                    auto result(lex.readInt());
+                    if(result < 1 || result > mMax)
+                        lex.fail(mWhat + " " + ssvu::toStr(result) +
+                                 " out of range [1, " + ssvu::toStr(mMax) +
+                                 "]");
+                    lex.expect(',');
+                    return result;
+                });
+
+            lex.expect('[');
+            for(auto f : {&mP.x, &mP.y})
+            {
+                *f = lex.readInt();
+                lex.expect(',');
+            }
+            mP.cols = readDim(OBLELevel::maxCols, "level columns");
+            mP.rows = readDim(OBLELevel::maxRows, "level rows");
+            mP.depth = readDim(OBLELevel::maxDepth, "level depth");
+
+            // Tile keys are implied by the tile's position
+            readPairs([this, &mP](int)
+                {
+                    mP.tiles.emplace_back();
+                    readTile(mP.tiles.back());
+                });
+            lex.expect(']');
+        }
+
+        inline void readLevel(int mSector, int mKey)
+        {
+            Pending p;
+            p.sector = mSector;
+            p.key = mKey;
+            readLevelBody(p);
+
+            pending.emplace_back(ssvu::mv(p));
+            if(pending.size() >= workers.getCount() * 4) flush();
+        }
+
+        inline static OBLELevel getLevel(
+            const Pending& mP, std::vector<std::string>& mErrors)
+        {
+            OBLELevel result{mP.x, mP.y, mP.cols, mP.rows, mP.depth};
+            for(const auto& t : mP.tiles) result.set(t, 1, mErrors);
+            return result;
+        }
+
+        inline void flush()
+        {
+            std::vector<UPtr<OBLELevel>> levels(pending.size());
+            std::vector<std::vector<std::string>> errors(pending.size());
+            workers.forRanges(pending.size(), [this, &levels, &errors](
+                                                  SizeT mBegin, SizeT mEnd)
+                {
+                    for(auto i(mBegin); i < mEnd; ++i)
+                        levels[i] = ssvu::mkUPtr<OBLELevel>(
+                            getLevel(pending[i], errors[i]));
+                });
+
+            for(auto i(0u); i < pending.size(); ++i)
+            {
+                OBLELevel::logErrors(errors[i]);
+                result.getSector(pending[i].sector)
+                    .getLevels()[pending[i].key] = ssvu::mv(*levels[i]);
+            }
+
+            pending.clear();
+        }
+
+        inline OBLEJsonReader(std::streambuf& mBuf, OBWorkers& mWorkers)
+            : lex{mBuf}, workers(mWorkers)
+        {
+        }
+        inline OBLEJsonReader(std::streambuf& mBuf, OBWorkers& mWorkers,
+            const OBLEJsonLexer::Pos& mPos)
+            : lex{mBuf, mPos}, workers(mWorkers)
+        {
+        }
+
+        inline OBLEPack read()
+        {
+            lex.expect('[');
+            result.setName(lex.readStr());
+            lex.expect(',');
+
+            readPairs([this](int mSector)
+                {
+                    result.getSector(mSector);
+                    readPairs([this, mSector](int mKey)
+                        {
+                            readLevel(mSector, mKey);
+                        });
+                });
+
+            lex.expect(']');
+            lex.expectEnd();
+
+            flush();
+            return ssvu::mv(result);
+        }
+
+        // Reads the pack's structure, recording where every level starts -
+        // level `i` of `mPositions` is stored as record `i`
+        inline OBLEPack readIndex(std::vector<OBLEJsonLexer::Pos>& mPositions)
+        {
+            lex.expect('[');
+            result.setName(lex.readStr());
+            lex.expect(',');
+
+            readPairs([this, &mPositions](int mSector)
+                {
+                    auto& sector(result.getSector(mSector));
+                    readPairs([this, &mPositions, &sector](int mKey)
+                        {
+                            lex.peek();
+                            sector.addStored(mKey, mPositions.size());
+                            mPositions.emplace_back(lex.getPos());
+                            lex.skipValue();
+                        });
+                });
+
+            lex.expect(']');
+            lex.expectEnd();
+            return ssvu::mv(result);
+        }
+
+    public:
+        inline static OBLEPack read(std::istream& mIn, OBWorkers& mWorkers)
+        {
+            return OBLEJsonReader{*mIn.rdbuf(), mWorkers}.read();
+        }
+
+        inline static OBLEPack readFromFile(
+            const std::string& mPath, OBWorkers& mWorkers)
+        {
+            std::ifstream ifs{mPath, std::ios::binary};
+            if(!ifs) throw std::runtime_error{"Can't open " + mPath};
+            return read(ifs, mWorkers);
+        }
+
+        // Reads only the pack's index - the file is kept open, and levels
+        // are read from it on first access
+        inline static OBLEPack open(const std::string& mPath)
+        {
+            auto file(std::make_shared<std::ifstream>(mPath, std::ios::binary));
+            if(!*file) throw std::runtime_error{"Can't open " + mPath};
+
+            OBWorkers serial{1};
+            auto positions(
+                std::make_shared<std::vector<OBLEJsonLexer::Pos>>());
+            auto result(OBLEJsonReader{*file->rdbuf(), serial}.readIndex(
+                *positions));
+
+            result.setLoader([file, positions](SizeT mIdx)
+                {
+                    const auto& pos((*positions)[mIdx]);
+                    if(file->rdbuf()->pubseekpos(pos.offset) !=
+                        std::streampos(pos.offset))
+                        throw std::runtime_error{"Can't seek pack file"};
+
+                    OBWorkers serial{1};
+                    OBLEJsonReader reader{*file->rdbuf(), serial, pos};
+                    Pending p;
+                    reader.readLevelBody(p);
+
+                    std::vector<std::string> errors;
+                    auto level(getLevel(p, errors));
+                    OBLELevel::logErrors(errors);
+                    return level;
+                });
+
+            return result;
+        }
+    };
+}
+
+#endif
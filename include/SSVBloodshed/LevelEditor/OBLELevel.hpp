@@ -11,67 +11,228 @@
 
 namespace ob
 {
-    class OBLESector;
+    class OBLEPack;
+    class OBLEBinary;
 
+    // Tiles are stored as one dense cols * rows array per z layer, laid out
+    // back to back from the lowest layer up - every cell of the level exists,
+    // so lookups are plain index math and reads never allocate
+    //
+    // Params are sparse: they live in a side table keyed by cell index, and
+    // cells with params point to their entry
     class OBLELevel
     {
-        friend OBLESector;
-        SSVJ_CNV_FRIEND();
+        friend OBLEPack;
+        friend OBLEBinary;
+
+    public:
+        // Largest levels packs may contain - tile coordinates must fit in
+        // 16 bits, and the tile array must stay small
+        static constexpr int maxCols{256}, maxRows{256}, maxDepth{16};
+
+        inline static bool isValidSize(
+            int mCols, int mRows, int mDepth) noexcept
+        {
+            return mCols > 0 && mRows > 0 && mDepth > 0 &&
+                   mCols <= maxCols && mRows <= maxRows && mDepth <= maxDepth;
+        }
 
     private:
         int cols{levelCols}, rows{levelRows}, depth{5};
         int x{0}, y{0};
-        std::unordered_map<int, OBLETile> tiles;
+        std::vector<OBLETile> tiles;
+        std::unordered_map<int, OBLETileParams> params;
 
-    public:
-        inline OBLELevel() = default;
+        inline int getIdx(int mX, int mY, int mZ) const noexcept
+        {
+            return ((mZ + depth) * rows + mY) * cols + mX;
+        }
+        inline int getIdx(const OBLETile& mTile) const noexcept
+        {
+            return &mTile - tiles.data();
+        }
 
-        inline void clear(const OBLEDatabaseEntry& mDefaultEntry)
+        inline void initTiles()
         {
             tiles.clear();
-            for(int iX{0}; iX < cols; ++iX)
+            tiles.resize(cols * rows * depth * 2);
+            params.clear();
+
+            for(int iZ{-depth}; iZ < depth; ++iZ)
                 for(int iY{0}; iY < rows; ++iY)
-                    getTile(iX, iY, 0).initFromEntry(mDefaultEntry);
+                    for(int iX{0}; iX < cols; ++iX)
+                    {
+                        auto& t(tiles[getIdx(iX, iY, iZ)]);
+                        t.x = iX;
+                        t.y = iY;
+                        t.z = iZ;
+                    }
         }
 
-        inline void del(int mX, int mY, int mZ)
+        // Unordered map nodes survive moves, but copies need their cells
+        // pointed at the new table
+        inline void bindParams() noexcept
         {
-            tiles.erase(ssvu::get1DIdxFrom3D(mX, mY, mZ, cols, rows));
+            for(auto& t : tiles) t.params = nullptr;
+            for(auto& p : params) tiles[p.first].params = &p.second;
         }
-        inline void del(OBLETile& mTile)
+
+    public:
+        inline OBLELevel() { initTiles(); }
+        inline OBLELevel(int mX, int mY, int mCols, int mRows, int mDepth)
+            : cols{mCols}, rows{mRows}, depth{mDepth}, x{mX}, y{mY}
         {
-            del(mTile.getX(), mTile.getY(), mTile.getZ());
+            initTiles();
         }
 
-        inline void update()
+        inline OBLELevel(const OBLELevel& mL)
+            : cols{mL.cols}, rows{mL.rows}, depth{mL.depth}, x{mL.x},
+              y{mL.y}, tiles{mL.tiles}, params{mL.params}
         {
-            for(auto& t : tiles) t.second.update();
+            bindParams();
         }
-        inline void draw(sf::RenderTarget& mRenderTarget, bool mOnion,
-            bool mShowId, int mCurrentZ = 0)
+        inline OBLELevel& operator=(const OBLELevel& mL)
         {
-            std::vector<std::pair<int, sf::Sprite>> toDraw;
-            for(auto& t : tiles)
+            auto copy(mL);
+            return *this = ssvu::mv(copy);
+        }
+        inline OBLELevel(OBLELevel&&) = default;
+        inline OBLELevel& operator=(OBLELevel&&) = default;
+
+        inline void clear(const OBLEDatabaseEntry& mDefaultEntry)
+        {
+            initTiles();
+            for(int iY{0}; iY < rows; ++iY)
+                for(int iX{0}; iX < cols; ++iX)
+                    init(getTile(iX, iY, 0), mDefaultEntry);
+        }
+
+        inline void setParams(OBLETile& mTile, const OBLEParams& mParams)
+        {
+            auto idx(getIdx(mTile));
+            if(mParams.empty())
             {
-                sf::Sprite s{t.second.getSprite()};
-                if(mOnion)
-                    s.setColor(sf::Color(
-                        255, 255, 255,
-                        ssvu::getClamped(
-                            255 - std::abs(t.second.getZ() - mCurrentZ) * 50, 0,
-                            255)));
-                toDraw.emplace_back(t.second.getZ(), s);
+                params.erase(idx);
+                mTile.params = nullptr;
+                return;
             }
 
-            ssvu::sortStable(toDraw, [](const auto& mA, const auto& mB)
+            auto& p(params[idx]);
+            p.values = mParams;
+            mTile.params = &p;
+        }
+        inline void set(
+            OBLETile& mTile, OBLETType mType, const OBLEParams& mParams)
+        {
+            mTile.type = mType;
+            setParams(mTile, mParams);
+        }
+
+        // Sets a tile from its serialized form, validating its params
+        // against its type's schema - `mRun` repeats it on the following
+        // tiles of its row
+        //
+        // Problems are appended to `mErrors`, so that levels built on
+        // worker threads can report them afterwards, in order
+        inline void set(const OBLETileData& mData, int mRun,
+            std::vector<std::string>& mErrors)
+        {
+            auto getPrefix([&mData]
                 {
-                    return mA.first > mB.first;
+                    return "Tile (" + ssvu::toStr(mData.x) + ";" +
+                           ssvu::toStr(mData.y) + ";" +
+                           ssvu::toStr(mData.z) + ")";
                 });
-            for(auto& td : toDraw) mRenderTarget.draw(td.second);
+
+            if(mRun < 1 || !isValid(mData.x, mData.y, mData.z) ||
+                !isValid(mData.x + mRun - 1, mData.y, mData.z))
+            {
+                mErrors.emplace_back(getPrefix() + " is out of bounds");
+                return;
+            }
+
+            std::vector<std::string> errors;
+            auto tParams(getSchema(mData.type).fromMap(mData.params, errors));
+            for(auto i(0); i < mRun; ++i)
+                set(getTile(mData.x + i, mData.y, mData.z), mData.type,
+                    tParams);
+
+            for(const auto& e : errors)
+                mErrors.emplace_back(getPrefix() + ": " + e);
+        }
+        inline void set(const OBLETileData& mData, int mRun = 1)
+        {
+            std::vector<std::string> errors;
+            set(mData, mRun, errors);
+            logErrors(errors);
+        }
+
+        inline static void logErrors(const std::vector<std::string>& mErrors)
+        {
+            for(const auto& e : mErrors)
+                ssvu::lo("ob::OBLELevel::set") << e << "\n";
+        }
+
+        inline void init(OBLETile& mTile, const OBLEDatabaseEntry& mEntry)
+        {
+            set(mTile, mEntry.type, getSchema(mEntry.type).getDefaults());
+        }
+
+        inline void del(int mX, int mY, int mZ) { del(getTile(mX, mY, mZ)); }
+        inline void del(OBLETile& mTile)
+        {
+            set(mTile, OBLETType::LETNull, {});
+        }
+
+        // Visits every non-null tile in storage order: layers from the
+        // lowest up, each row-major
+        template <typename TF>
+        inline void forTiles(const TF& mFn)
+        {
+            for(auto& t : tiles)
+                if(!t.isNull()) mFn(t);
+        }
+        template <typename TF>
+        inline void forTiles(const TF& mFn) const
+        {
+            for(const auto& t : tiles)
+                if(!t.isNull()) mFn(t);
+        }
+
+        inline void draw(sf::RenderTarget& mRenderTarget,
+            const OBLEDatabase& mDatabase, bool mOnion, bool mShowId,
+            int mCurrentZ = 0)
+        {
+            // Higher layers are drawn first, so walk the layers downwards
+            for(int iZ{depth - 1}; iZ >= -depth; --iZ)
+            {
+                auto begin(getIdx(0, 0, iZ));
+                for(auto i(begin); i < begin + cols * rows; ++i)
+                {
+                    const auto& t(tiles[i]);
+                    if(t.isNull()) continue;
+
+                    const auto& e(mDatabase.get(t.type));
+                    sf::Sprite s{*e.texture, e.intRect};
+                    s.setOrigin(e.intRect.width / 2.f, e.intRect.height / 2.f);
+                    s.setRotation(t.hasParam(OBLEPKey::Rot)
+                                      ? t.getParam<int>(OBLEPKey::Rot)
+                                      : 0);
+                    s.setPosition(t.x * 10.f, t.y * 10.f);
+
+                    if(mOnion)
+                        s.setColor(sf::Color(255, 255, 255,
+                            ssvu::getClamped(
+                                255 - std::abs(iZ - mCurrentZ) * 50, 0, 255)));
+
+                    mRenderTarget.draw(s);
+                }
+            }
+
             if(mShowId)
-                for(auto& t : tiles)
-                    if(t.second.hasParam("id"))
-                        mRenderTarget.draw(t.second.getIdText());
+                for(auto& p : params)
+                    if(p.second.values.has(OBLEPKey::Id))
+                        mRenderTarget.draw(p.second.idText);
         }
 
         inline int getColumns() const noexcept { return cols; }
@@ -81,23 +242,28 @@ namespace ob
         inline int getHeight() const noexcept { return rows * 10; }
         inline int getX() const noexcept { return x; }
         inline int getY() const noexcept { return y; }
+        inline SizeT getParamsCount() const noexcept { return params.size(); }
+
+        // Approximate heap usage, for the pack's level cache
+        inline SizeT getMemorySize() const noexcept
+        {
+            return tiles.capacity() * sizeof(OBLETile) +
+                   params.size() * (sizeof(OBLETileParams) + sizeof(void*) * 2);
+        }
         inline bool isValid(int mX, int mY, int mZ) const noexcept
         {
             return mX >= 0 && mY >= 0 && mZ >= -depth && mX < cols &&
                    mY < rows && mZ < depth;
         }
-        inline const decltype(tiles)& getTiles() const noexcept
+        inline OBLETile& getTile(int mX, int mY, int mZ) noexcept
         {
-            return tiles;
+            SSVU_ASSERT(isValid(mX, mY, mZ));
+            return tiles[getIdx(mX, mY, mZ)];
         }
-        inline decltype(tiles)& getTiles() noexcept { return tiles; }
-        inline OBLETile& getTile(int mX, int mY, int mZ) noexcept
+        inline const OBLETile& getTile(int mX, int mY, int mZ) const noexcept
         {
-            auto& t(tiles[ssvu::get1DIdxFrom3D(mX, mY, mZ, cols, rows)]);
-            t.setX(mX);
-            t.setY(mY);
-            t.setZ(mZ);
-            return t;
+            SSVU_ASSERT(isValid(mX, mY, mZ));
+            return tiles[getIdx(mX, mY, mZ)];
         }
     };
 }
@@ -0,0 +1,101 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_MAPPEDFILE
+#define SSVOB_LEVELEDITOR_MAPPEDFILE
+
+#include <fstream>
+#include "SSVBloodshed/OBCommon.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SSVOB_MMAP 1
+#endif
+
+namespace ob
+{
+    // Read-only view of a whole file - memory-mapped where the platform
+    // supports it, read into a buffer otherwise
+    class OBLEMappedFile
+    {
+    private:
+        const char* data{nullptr};
+        SizeT size{0};
+        std::vector<char> buffer;
+        bool mapped{false};
+
+        inline void close() noexcept
+        {
+#ifdef SSVOB_MMAP
+            if(mapped) munmap(const_cast<char*>(data), size);
+#endif
+            data = nullptr;
+            size = 0;
+            mapped = false;
+            buffer.clear();
+        }
+
+        inline bool read(const std::string& mPath)
+        {
+            std::ifstream ifs{mPath, std::ios::binary};
+            if(!ifs) return false;
+
+            buffer.assign(std::istreambuf_iterator<char>{ifs},
+                std::istreambuf_iterator<char>{});
+            data = buffer.data();
+            size = buffer.size();
+            return true;
+        }
+
+#ifdef SSVOB_MMAP
+        inline bool map(const std::string& mPath)
+        {
+            auto fd(::open(mPath.c_str(), O_RDONLY));
+            if(fd == -1) return false;
+
+            struct stat st;
+            if(fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            auto ptr(mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+            ::close(fd);
+            if(ptr == MAP_FAILED) return false;
+
+            data = static_cast<const char*>(ptr);
+            size = st.st_size;
+            mapped = true;
+            return true;
+        }
+#endif
+
+    public:
+        inline OBLEMappedFile() = default;
+        inline OBLEMappedFile(const std::string& mPath) { open(mPath); }
+        inline ~OBLEMappedFile() { close(); }
+
+        OBLEMappedFile(const OBLEMappedFile&) = delete;
+        OBLEMappedFile& operator=(const OBLEMappedFile&) = delete;
+
+        inline bool open(const std::string& mPath)
+        {
+            close();
+#ifdef SSVOB_MMAP
+            if(map(mPath)) return true;
+#endif
+            return read(mPath);
+        }
+
+        inline const char* getData() const noexcept { return data; }
+        inline SizeT getSize() const noexcept { return size; }
+        inline bool isOpen() const noexcept { return data != nullptr; }
+    };
+}
+
+#endif
@@ -11,16 +11,75 @@
 
 namespace ob
 {
+    // Packs opened from a file only read its index up front - levels are
+    // read by `loader` on first access, and the least recently used ones
+    // are evicted again once resident levels exceed `memoryCap`
+    //
+    // Only levels that still have a stored copy are ever evicted, and a
+    // cap of 0 disables eviction altogether - the editor relies on that to
+    // keep unsaved changes
+    //
+    // Evictable levels are also indexed by their last use in `lru`, so
+    // touching and evicting a level never scans the resident ones
     class OBLEPack
     {
-        SSVJ_CNV_FRIEND();
+    public:
+        using Loader = ssvu::Func<OBLELevel(SizeT)>;
 
     private:
+        using LevelId = std::pair<int, int>; // Sector index, level key
+
+        struct Resident
+        {
+            SizeT bytes, lastUse;
+        };
+
         std::string name{"unnamed pack"};
         std::unordered_map<int, OBLESector> sectors;
+        Loader loader;
+        std::map<LevelId, Resident> residents;
+        std::map<SizeT, LevelId> lru; // Last use -> evictable level
+        SizeT memoryCap{0}, residentBytes{0}, useCount{0};
+
+        inline void touch(
+            const LevelId& mId, const OBLELevel& mLevel, bool mStored)
+        {
+            auto& r(residents[mId]);
+            lru.erase(r.lastUse);
+            residentBytes -= r.bytes;
+            r.bytes = mLevel.getMemorySize();
+            r.lastUse = ++useCount;
+            residentBytes += r.bytes;
+            if(mStored) lru.emplace(r.lastUse, mId);
+        }
+
+        inline void forget(std::map<LevelId, Resident>::iterator mItr)
+        {
+            lru.erase(mItr->second.lastUse);
+            residentBytes -= mItr->second.bytes;
+            residents.erase(mItr);
+        }
+
+        inline void evict()
+        {
+            // The most recently used level always stays
+            while(memoryCap > 0 && residentBytes > memoryCap && !lru.empty() &&
+                  std::begin(lru)->first != useCount)
+            {
+                auto id(std::begin(lru)->second);
+                sectors.at(id.first).levels.erase(id.second);
+                forget(residents.find(id));
+            }
+        }
 
     public:
         inline void setName(std::string mName) { name = ssvu::mv(mName); }
+        inline void setLoader(Loader mLoader) { loader = ssvu::mv(mLoader); }
+        inline void setMemoryCap(SizeT mBytes)
+        {
+            memoryCap = mBytes;
+            evict();
+        }
 
         inline const std::string& getName() const noexcept { return name; }
         inline const decltype(sectors)& getSectors() const noexcept
@@ -36,6 +95,69 @@ namespace ob
         {
             return sectors.count(mIdx) > 0;
         }
+
+        // Returns the level, reading it from the pack file if it's only
+        // stored there, or creating it if it doesn't exist at all
+        inline OBLELevel& getLevel(int mSectorIdx, int mX, int mY)
+        {
+            auto& sector(getSector(mSectorIdx));
+            auto key(sector.getKey(mX, mY));
+
+            auto sItr(sector.stored.find(key));
+            auto stored(sItr != std::end(sector.stored));
+
+            auto itr(sector.levels.find(key));
+            if(itr == std::end(sector.levels))
+                itr = sector.levels
+                          .emplace(key, stored ? loader(sItr->second)
+                                               : OBLELevel{})
+                          .first;
+
+            auto& result(itr->second);
+            result.x = mX;
+            result.y = mY;
+
+            touch({mSectorIdx, key}, result, stored);
+            evict();
+            return result;
+        }
+
+        inline void clearSector(int mSectorIdx)
+        {
+            auto& sector(getSector(mSectorIdx));
+            for(const auto& p : sector.levels)
+            {
+                auto itr(residents.find({mSectorIdx, p.first}));
+                if(itr != std::end(residents)) forget(itr);
+            }
+
+            sector.levels.clear();
+            sector.stored.clear();
+        }
+
+        // Visits every level of a sector in ascending key order - stored
+        // levels are read into a temporary, without becoming resident
+        template <typename TF>
+        inline void forLevels(const OBLESector& mSector, const TF& mFn) const
+        {
+            for(auto key : mSector.getLevelKeys())
+            {
+                auto itr(mSector.levels.find(key));
+                if(itr != std::end(mSector.levels))
+                    mFn(key, itr->second);
+                else
+                    mFn(key, loader(mSector.stored.at(key)));
+            }
+        }
+
+        inline SizeT getResidentCount() const noexcept
+        {
+            return residents.size();
+        }
+        inline SizeT getResidentBytes() const noexcept
+        {
+            return residentBytes;
+        }
     };
 }
 
@@ -0,0 +1,351 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_PARAMS
+#define SSVOB_LEVELEDITOR_PARAMS
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Serialized form of a tile's params - JSON and binary packs store them
+    // by name
+    using OBLEParamMap = std::map<std::string, ssvj::Val>;
+
+    // Interned param keys - every key has the same name and type for every
+    // tile type that uses it
+    enum class OBLEPKey : std::uint8_t
+    {
+        Id,
+        Rot,
+        Open,
+        EnemyType,
+        DelayStart,
+        DelaySpawn,
+        SpawnCount,
+        Action,
+        PlayerOnly,
+        BlockFriendly,
+        BlockEnemy,
+        ForceMult,
+        Count
+    };
+
+    enum class OBLEPType : std::uint8_t
+    {
+        Int,
+        Real,
+        Bool
+    };
+
+    constexpr SizeT pKeyCount{SizeT(OBLEPKey::Count)};
+
+    struct OBLEPKeyInfo
+    {
+        const char* name;
+        OBLEPType type;
+        const char* enumName; // Null for non-enum keys
+    };
+
+    inline const OBLEPKeyInfo& getPKeyInfo(OBLEPKey mKey) noexcept
+    {
+        static OBLEPKeyInfo infos[]{{"id", OBLEPType::Int, nullptr},
+            {"rot", OBLEPType::Int, nullptr},
+            {"open", OBLEPType::Bool, nullptr},
+            {"enemyType", OBLEPType::Int, "SpawnerItem"},
+            {"delayStart", OBLEPType::Real, nullptr},
+            {"delaySpawn", OBLEPType::Real, nullptr},
+            {"spawnCount", OBLEPType::Int, nullptr},
+            {"action", OBLEPType::Int, "IdAction"},
+            {"playerOnly", OBLEPType::Bool, nullptr},
+            {"blockFriendly", OBLEPType::Bool, nullptr},
+            {"blockEnemy", OBLEPType::Bool, nullptr},
+            {"forceMult", OBLEPType::Real, nullptr}};
+
+        SSVU_ASSERT(mKey < OBLEPKey::Count);
+        return infos[SizeT(mKey)];
+    }
+
+    // Returns `OBLEPKey::Count` for unknown names
+    inline OBLEPKey getPKey(const std::string& mName) noexcept
+    {
+        for(auto i(0u); i < pKeyCount; ++i)
+            if(mName == getPKeyInfo(OBLEPKey(i)).name) return OBLEPKey(i);
+        return OBLEPKey::Count;
+    }
+
+    // Compact typed param storage: one slot per interned key, and a mask
+    // of the keys that are set - lookups are a bit test and an array read
+    class OBLEParams
+    {
+    private:
+        union Val
+        {
+            int i;
+            float f;
+            bool b;
+        };
+
+        std::array<Val, pKeyCount> vals{};
+        std::uint16_t mask{0};
+
+        inline static auto getBit(OBLEPKey mKey) noexcept
+        {
+            return std::uint16_t(1u << SizeT(mKey));
+        }
+
+    public:
+        inline bool has(OBLEPKey mKey) const noexcept
+        {
+            return (mask & getBit(mKey)) != 0;
+        }
+        inline bool empty() const noexcept { return mask == 0; }
+
+        // Whether both have `mKey` unset, or set to the same value
+        inline bool isSame(const OBLEParams& mP, OBLEPKey mKey) const noexcept
+        {
+            if(has(mKey) != mP.has(mKey)) return false;
+            if(!has(mKey)) return true;
+
+            const auto &a(vals[SizeT(mKey)]), &b(mP.vals[SizeT(mKey)]);
+            switch(getPKeyInfo(mKey).type)
+            {
+                case OBLEPType::Int: return a.i == b.i;
+                case OBLEPType::Real: return a.f == b.f;
+                default: return a.b == b.b;
+            }
+        }
+        inline bool operator==(const OBLEParams& mP) const noexcept
+        {
+            if(mask != mP.mask) return false;
+            for(auto i(0u); i < pKeyCount; ++i)
+                if(!isSame(mP, OBLEPKey(i))) return false;
+            return true;
+        }
+        inline bool operator!=(const OBLEParams& mP) const noexcept
+        {
+            return !(*this == mP);
+        }
+
+        template <typename T>
+        inline T get(OBLEPKey mKey) const noexcept
+        {
+            SSVU_ASSERT(has(mKey));
+            const auto& v(vals[SizeT(mKey)]);
+
+            switch(getPKeyInfo(mKey).type)
+            {
+                case OBLEPType::Int: return T(v.i);
+                case OBLEPType::Real: return T(v.f);
+                default: return T(v.b);
+            }
+        }
+
+        // Stores `mValue` converted to the key's type
+        template <typename T>
+        inline void set(OBLEPKey mKey, T mValue) noexcept
+        {
+            auto& v(vals[SizeT(mKey)]);
+
+            switch(getPKeyInfo(mKey).type)
+            {
+                case OBLEPType::Int: v.i = int(mValue); break;
+                case OBLEPType::Real: v.f = float(mValue); break;
+                default: v.b = mValue != T(0); break;
+            }
+
+            mask |= getBit(mKey);
+        }
+
+        inline ssvj::Val getVal(OBLEPKey mKey) const
+        {
+            switch(getPKeyInfo(mKey).type)
+            {
+                case OBLEPType::Int: return ssvj::IntS(get<int>(mKey));
+                case OBLEPType::Real: return ssvj::Real(get<float>(mKey));
+                default: return get<bool>(mKey);
+            }
+        }
+
+        template <typename TF>
+        inline void forEach(const TF& mFn) const
+        {
+            for(auto i(0u); i < pKeyCount; ++i)
+                if(has(OBLEPKey(i))) mFn(OBLEPKey(i));
+        }
+
+        inline OBLEParamMap toMap() const
+        {
+            OBLEParamMap result;
+            forEach([this, &result](OBLEPKey mKey)
+                {
+                    result[getPKeyInfo(mKey).name] = getVal(mKey);
+                });
+            return result;
+        }
+    };
+
+    struct OBLEPDef
+    {
+        OBLEPKey key;
+        float def, min, max;
+    };
+
+    // Params declared by a tile type, with their defaults and ranges
+    class OBLESchema
+    {
+    private:
+        std::vector<OBLEPDef> defs;
+        OBLEParams defaults;
+
+        inline static bool getNumber(const ssvj::Val& mVal, float& mOut)
+        {
+            if(mVal.is<ssvj::IntS>())
+                mOut = mVal.as<ssvj::IntS>();
+            else if(mVal.is<ssvj::IntU>())
+                mOut = mVal.as<ssvj::IntU>();
+            else if(mVal.is<ssvj::Real>())
+                mOut = mVal.as<ssvj::Real>();
+            else if(mVal.is<bool>())
+                mOut = mVal.as<bool>() ? 1.f : 0.f;
+            else
+                return false;
+
+            return true;
+        }
+
+    public:
+        inline OBLESchema() = default;
+        inline OBLESchema(std::initializer_list<OBLEPDef> mDefs) : defs{mDefs}
+        {
+            for(const auto& d : defs) defaults.set(d.key, d.def);
+        }
+
+        inline const OBLEPDef* find(OBLEPKey mKey) const noexcept
+        {
+            for(const auto& d : defs)
+                if(d.key == mKey) return &d;
+            return nullptr;
+        }
+
+        // Enum keys are always bound by their enum's size
+        inline float getMax(const OBLEPDef& mDef) const
+        {
+            const auto& info(getPKeyInfo(mDef.key));
+            if(info.enumName == nullptr) return mDef.max;
+            return getEnumStrVecByName(info.enumName).size() - 1;
+        }
+        inline float getClamped(const OBLEPDef& mDef, float mValue) const
+        {
+            return ssvu::getClamped(mValue, mDef.min, getMax(mDef));
+        }
+
+        // Builds typed params from serialized ones - unknown keys, values
+        // of the wrong type and values out of range are reported in
+        // `mErrors`, and replaced by defaults or clamped
+        inline OBLEParams fromMap(
+            const OBLEParamMap& mMap, std::vector<std::string>& mErrors) const
+        {
+            auto result(defaults);
+
+            for(const auto& p : mMap)
+            {
+                auto def(find(getPKey(p.first)));
+                if(def == nullptr)
+                {
+                    mErrors.emplace_back("unknown param <" + p.first + ">");
+                    continue;
+                }
+
+                float value;
+                bool isBool{getPKeyInfo(def->key).type == OBLEPType::Bool};
+                if(!getNumber(p.second, value) || isBool != p.second.is<bool>())
+                {
+                    mErrors.emplace_back("wrong type for <" + p.first + ">");
+                    continue;
+                }
+
+                auto clamped(getClamped(*def, value));
+                if(clamped != value)
+                    mErrors.emplace_back("<" + p.first + "> out of range");
+
+                result.set(def->key, clamped);
+            }
+
+            return result;
+        }
+
+        inline bool isDefault(
+            const OBLEParams& mParams, OBLEPKey mKey) const noexcept
+        {
+            return defaults.isSame(mParams, mKey);
+        }
+
+        // Serialized form of `mParams` without the values equal to their
+        // defaults - `fromMap` starts from the defaults, so it reads back
+        // the same params
+        inline OBLEParamMap toMap(const OBLEParams& mParams) const
+        {
+            OBLEParamMap result;
+            mParams.forEach([this, &mParams, &result](OBLEPKey mKey)
+                {
+                    if(!isDefault(mParams, mKey))
+                        result[getPKeyInfo(mKey).name] = mParams.getVal(mKey);
+                });
+            return result;
+        }
+
+        inline const auto& getDefs() const noexcept { return defs; }
+        inline const auto& getDefaults() const noexcept { return defaults; }
+    };
+
+    inline const OBLESchema& getSchema(OBLETType mType)
+    {
+        using K = OBLEPKey;
+        constexpr float maxId{9999.f}, maxDelay{100000.f};
+
+        static OBLESchema empty;
+        static OBLESchema rot{{K::Rot, 0, 0, 359}};
+        static OBLESchema open{{K::Open, 0, 0, 1}};
+        static OBLESchema pPlate{{K::Id, 0, -1, maxId}, {K::Action, 0, 0, 0},
+            {K::PlayerOnly, 0, 0, 1}};
+
+        static std::map<OBLETType, OBLESchema> schemas{
+            {OBLETType::LETTurretSP, rot}, {OBLETType::LETTurretCP, rot},
+            {OBLETType::LETTurretBP, rot}, {OBLETType::LETTurretRL, rot},
+            {OBLETType::LETPlayer, rot}, {OBLETType::LETRunner, rot},
+            {OBLETType::LETRunnerArmed, rot}, {OBLETType::LETCharger, rot},
+            {OBLETType::LETChargerArmed, rot}, {OBLETType::LETJuggernaut, rot},
+            {OBLETType::LETJuggernautArmed, rot}, {OBLETType::LETGiant, rot},
+            {OBLETType::LETEnforcer, rot},
+            {OBLETType::LETExplosiveCrate, {{K::Id, -1, -1, maxId}}},
+            {OBLETType::LETDoor, {{K::Id, 0, -1, maxId}, {K::Open, 0, 0, 1}}},
+            {OBLETType::LETDoorG, open}, {OBLETType::LETDoorR, open},
+            {OBLETType::LETSpawner,
+                {{K::Id, -1, -1, maxId}, {K::EnemyType, 0, 0, 0},
+                    {K::DelayStart, 0, 0, maxDelay},
+                    {K::DelaySpawn, 200, 0, maxDelay},
+                    {K::SpawnCount, 1, 0, 1000}}},
+            {OBLETType::LETPPlateSingle, pPlate},
+            {OBLETType::LETPPlateMulti, pPlate},
+            {OBLETType::LETPPlateOnOff, pPlate},
+            {OBLETType::LETForceField,
+                {{K::Id, 0, -1, maxId}, {K::Rot, 0, 0, 359},
+                    {K::BlockFriendly, 1, 0, 1}, {K::BlockEnemy, 1, 0, 1},
+                    {K::ForceMult, 100, -1000, 1000}}},
+            {OBLETType::LETBulletForceField,
+                {{K::Id, 0, -1, maxId}, {K::Rot, 0, 0, 359},
+                    {K::BlockFriendly, 1, 0, 1}, {K::BlockEnemy, 1, 0, 1}}},
+            {OBLETType::LETPjBooster,
+                {{K::Id, 0, -1, maxId}, {K::Rot, 0, 0, 359},
+                    {K::ForceMult, 100, -1000, 1000}}},
+            {OBLETType::LETPjChanger,
+                {{K::Id, 0, -1, maxId}, {K::Rot, 0, 0, 359}}}};
+
+        auto itr(schemas.find(mType));
+        return itr == std::end(schemas) ? empty : itr->second;
+    }
+}
+
+#endif
@@ -10,13 +10,19 @@
 
 namespace ob
 {
+    class OBLEPack;
+
+    // Levels are either resident or still stored in the pack file, known
+    // only by their record index - the pack faults stored levels in on
+    // first access
     class OBLESector
     {
-        SSVJ_CNV_FRIEND();
+        friend OBLEPack;
 
     private:
         int cols, rows;
         std::unordered_map<int, OBLELevel> levels;
+        std::unordered_map<int, SizeT> stored;
 
     public:
         inline OBLESector(int mCols = 100, int mRows = 100) noexcept
@@ -24,25 +30,46 @@ namespace ob
               rows{mRows}
         {
         }
-        inline void clear() noexcept { levels.clear(); }
 
         inline int getColumns() const noexcept { return cols; }
         inline int getRows() const noexcept { return rows; }
+        inline int getKey(int mX, int mY) const noexcept
+        {
+            return ssvu::get1DIdxFrom2D(mX, mY, cols);
+        }
+
+        // Resident levels only
         inline const decltype(levels)& getLevels() const noexcept
         {
             return levels;
         }
         inline decltype(levels)& getLevels() noexcept { return levels; }
-        inline OBLELevel& getLevel(int mX, int mY) noexcept
+
+        inline const decltype(stored)& getStored() const noexcept
+        {
+            return stored;
+        }
+        inline void addStored(int mKey, SizeT mRecordIdx)
+        {
+            stored[mKey] = mRecordIdx;
+        }
+
+        // Keys of every level, resident or stored, in ascending order
+        inline std::vector<int> getLevelKeys() const
         {
-            auto& l(levels[ssvu::get1DIdxFrom2D(mX, mY, cols)]);
-            l.x = mX;
-            l.y = mY;
-            return l;
+            std::vector<int> result;
+            for(const auto& p : levels) result.emplace_back(p.first);
+            for(const auto& p : stored)
+                if(levels.count(p.first) == 0) result.emplace_back(p.first);
+
+            ssvu::sort(result);
+            return result;
         }
+
         inline bool isValid(int mX, int mY) const noexcept SSVU_ATTRIBUTE(pure)
         {
-            return levels.count(ssvu::get1DIdxFrom2D(mX, mY, cols)) > 0;
+            auto key(getKey(mX, mY));
+            return levels.count(key) > 0 || stored.count(key) > 0;
         }
     };
 }
@@ -0,0 +1,31 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELEDITOR_SPAWN
+#define SSVOB_LEVELEDITOR_SPAWN
+
+#include <type_traits>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEParams.hpp"
+
+namespace ob
+{
+    // Tile resolved for spawning - final params, and the wall mask of
+    // tiles that connect to their neighbors
+    //
+    // Baked packs store these as raw bytes, so they must stay trivially
+    // copyable
+    struct OBLESpawn
+    {
+        OBLEParams params;
+        OBLETType type;
+        std::int16_t x, y, z;
+        std::uint8_t mask, pad;
+        std::int32_t cluster; // Pressure plates only, -1 otherwise
+    };
+
+    static_assert(std::is_trivially_copyable<OBLESpawn>{}, "");
+}
+
+#endif
@@ -8,130 +8,143 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBAssets.hpp"
 #include "SSVBloodshed/LevelEditor/OBLEDatabase.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEParams.hpp"
 
 namespace ob
 {
+    class OBLELevel;
+
+    // Value form of a tile, used for serialization and copy-pasting
     struct OBLETileData
     {
         SSVJ_CNV_FRIEND();
 
-        std::map<std::string, ssvj::Val> params;
+        OBLEParamMap params;
         OBLETType type{OBLETType::LETNull};
         int x{-1}, y{-1}, z{-1};
     };
 
+    // Whether `mType` is a tile type packs may contain - older packs also
+    // hold erased (null) tiles
+    inline bool isValidTType(int mType) noexcept
+    {
+        return mType >= int(OBLETType::LETNull) &&
+               mType <= int(OBLETType::LETBulletForceField);
+    }
+
+    // Entry of a level's sparse params table - only tiles with params
+    // have one
+    struct OBLETileParams
+    {
+        OBLEParams values;
+        ssvs::BitmapText idText;
+    };
+
+    // Cell of a level's dense tile array - params live in the level's side
+    // table, and the sprite is built by the level when drawing
     class OBLETile
     {
-        SSVJ_CNV_FRIEND();
+        friend OBLELevel;
 
     private:
-        OBLETileData data;
-        sf::Sprite sprite;
-        ssvs::BitmapText idText;
+        OBLETileParams* params{nullptr};
+        OBLETType type{OBLETType::LETNull};
+        std::int16_t x{-1}, y{-1}, z{-1};
 
-    public:
-        inline OBLETile() {}
-        // inline OBLETile(const OBLETile& mTile) noexcept : data{mTile.data},
-        // params{mTile.params} { }
+        inline static const OBLEParams& getNoParams() noexcept
+        {
+            static OBLEParams result;
+            return result;
+        }
 
+    public:
         inline void refreshIdText(OBAssets& mAssets)
         {
+            if(!hasParam(OBLEPKey::Id)) return;
+
+            auto& idText(params->idText);
             idText = ssvs::BitmapText{*mAssets.obStroked};
 
             idText.setScale(0.5f, 0.5f);
             idText.setTracking(-3);
 
-            auto id(getParam<int>("id"));
-            idText.setPosition(data.x * 10.f - 4, data.y * 10.f - 5);
+            auto id(getParam<int>(OBLEPKey::Id));
+            idText.setPosition(x * 10.f - 4, y * 10.f - 5);
             idText.setString(id == 0 ? "" : ssvu::toStr(id));
         }
 
         inline void setRot(int mDeg) noexcept
         {
-            if(hasParam("rot")) data.params["rot"] = mDeg;
+            if(hasParam(OBLEPKey::Rot)) params->values.set(OBLEPKey::Rot, mDeg);
         }
         inline void setId(OBAssets& mAssets, int mId) noexcept
         {
-            if(!hasParam("id")) return;
-            data.params["id"] = mId;
+            if(!hasParam(OBLEPKey::Id)) return;
+            params->values.set(OBLEPKey::Id, mId);
             refreshIdText(mAssets);
         }
 
-        inline void setParam(const std::string& mKey, const std::string& mValue)
+        // Parses `mValue` as the key's type, clamped to the schema's range
+        inline void setParam(OBLEPKey mKey, const std::string& mValue)
         {
-            auto& p(data.params[mKey]);
+            const auto& schema(getSchema(type));
+            auto def(schema.find(mKey));
+            if(!hasParam(mKey) || def == nullptr) return;
+
             try
             {
-                if(p.is<ssvj::IntS>())
-                    p = ssvu::sToInt(mValue);
-                else if(p.is<ssvj::Real>())
-                    p = ssvu::sToFloat(mValue);
-                else if(p.is<bool>())
-                    p = mValue == "true" ? true : false;
+                float value;
+                switch(getPKeyInfo(mKey).type)
+                {
+                    case OBLEPType::Int: value = ssvu::sToInt(mValue); break;
+                    case OBLEPType::Real: value = ssvu::sToFloat(mValue); break;
+                    default: value = mValue == "true" ? 1.f : 0.f; break;
+                }
+
+                params->values.set(mKey, schema.getClamped(*def, value));
             }
             catch(const std::exception& mError)
             {
                 ssvu::lo("ob::OBLETile::setParam")
-                    << "Error setting parameter <" << mKey << ">: <" << mValue
-                    << ">!\n";
+                    << "Error setting parameter <" << getPKeyInfo(mKey).name
+                    << ">: <" << mValue << ">!\n";
                 ssvu::lo("ob::OBLETile::setParam") << mError.what()
                                                    << std::endl;
             }
         }
 
-        inline void update()
+        inline bool isNull() const noexcept
         {
-            sprite.setOrigin(sprite.getTextureRect().width / 2.f,
-                sprite.getTextureRect().height / 2.f);
-            sprite.setRotation(data.params.count("rot") > 0
-                                   ? data.params["rot"].as<int>()
-                                   : 0);
-            sprite.setPosition(data.x * 10.f, data.y * 10.f);
+            return type == OBLETType::LETNull;
         }
-
-        inline void initFromEntry(const OBLEDatabaseEntry& mEntry) noexcept
+        template <typename T>
+        inline T getParam(OBLEPKey mKey) const noexcept
         {
-            data.type = mEntry.type;
-            data.params = mEntry.defaultParams;
+            return getParams().get<T>(mKey);
         }
-        inline void initGfxFromEntry(const OBLEDatabaseEntry& mEntry) noexcept
+        inline bool hasParam(OBLEPKey mKey) const noexcept
         {
-            sprite.setTexture(*mEntry.texture);
-            sprite.setTextureRect(mEntry.intRect);
+            return params != nullptr && params->values.has(mKey);
         }
 
-        inline bool isNull() const noexcept
-        {
-            return data.type == OBLETType::LETNull;
-        }
-        inline void setX(int mX) noexcept { data.x = mX; }
-        inline void setY(int mY) noexcept { data.y = mY; }
-        inline void setZ(int mZ) noexcept { data.z = mZ; }
-        inline void setType(OBLETType mType) noexcept { data.type = mType; }
-        inline void setParams(decltype(data.params) mParams)
+        inline auto getType() const noexcept { return type; }
+        inline int getX() const noexcept { return x; }
+        inline int getY() const noexcept { return y; }
+        inline int getZ() const noexcept { return z; }
+        inline const OBLEParams& getParams() const noexcept
         {
-            data.params = ssvu::mv(mParams);
+            return params != nullptr ? params->values : getNoParams();
         }
-        template <typename T>
-        inline T getParam(const std::string& mKey)
+        inline auto& getIdText() noexcept { return params->idText; }
+        inline OBLETileData getData() const
         {
-            return data.params[mKey].as<T>();
+            return {getParams().toMap(), type, x, y, z};
         }
-        inline bool hasParam(const std::string& mKey) const noexcept
+        // Same as `getData`, without the params equal to their defaults
+        inline OBLETileData getCompactData() const
         {
-            return data.params.count(mKey) > 0;
+            return {getSchema(type).toMap(getParams()), type, x, y, z};
         }
-
-        inline auto getType() const noexcept { return data.type; }
-        inline auto getX() const noexcept { return data.x; }
-        inline auto getY() const noexcept { return data.y; }
-        inline auto getZ() const noexcept { return data.z; }
-        inline const auto& getSprite() const noexcept { return sprite; }
-        inline auto& getSprite() noexcept { return sprite; }
-        inline const auto& getParams() const noexcept { return data.params; }
-        inline auto& getParams() noexcept { return data.params; }
-        inline auto& getIdText() noexcept { return idText; }
-        inline const auto& getData() const noexcept { return data; }
     };
 }
 
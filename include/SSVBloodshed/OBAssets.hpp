@@ -8,6 +8,8 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
 #include "SSVBloodshed/Particles/OBParticleData.hpp"
+#include "SSVBloodshed/Behaviors/OBBehavior.hpp"
+#include "SSVBloodshed/Behaviors/OBBCompiler.hpp"
 
 namespace ob
 {
@@ -85,6 +87,9 @@ namespace ob
         OBParticleData pdCaseBullet, pdCaseRocket, pdShockwave,
             pdMuzzleShockwave;
 
+        // Enemy behaviors
+        OBBehavior bhCharger, bhJuggernaut, bhGiant, bhEnforcer;
+
 #define WALLTSDECL(x)                                                      \
     sf::IntRect x##Single, x##Cross, x##V, x##H, x##CornerSW, x##CornerSE, \
         x##CornerNW, x##CornerNE, x##VEndS, x##VEndN, x##HEndW, x##HEndE,  \
@@ -297,6 +302,17 @@ namespace ob
             pdShockwave = gpd("shockwave");
             pdMuzzleShockwave = gpd("muzzleShockwave");
 
+            // Enemy behaviors
+            auto gbh([this](const std::string& mName)
+                {
+                    return getBehaviorFromJson(
+                        ssvj::fromFile("Data/Behaviors/" + mName + ".json"));
+                });
+            bhCharger = gbh("charger");
+            bhJuggernaut = gbh("juggernaut");
+            bhGiant = gbh("giant");
+            bhEnforcer = gbh("enforcer");
+
 #undef T_TSSMALL
 #undef T_TSMEDIUM
 #undef T_TSBIG
@@ -138,6 +138,9 @@ namespace ob
     constexpr int levelWidthCoords{toCoords(levelWidthPx)};
     constexpr int levelHeightCoords{toCoords(levelHeightPx)};
 
+    // Index of an interned weapon type, see `OBWpnRegistry`
+    using OBWpnTypeId = std::uint16_t;
+
     // Game enums
     enum OBGroup : unsigned int
     {
@@ -317,6 +320,17 @@ namespace ob
         return Vec2<T>(getVecFromDir8(getDir8FromRad(ssvs::getRad(mVec))));
     }
 
+    // Player state carried between levels
+    struct OBPlayerData
+    {
+        Vec2i pos;
+        int currentWpn;
+        float health;
+        Dir8 dir;
+        int shards;
+        // Ammo and other stuff
+    };
+
     // Timeline shortcuts
     inline void repeat(ssvu::Timeline& mTimeline, const ssvu::Action& mAction,
         unsigned int mTimes, FT mWait)
@@ -327,16 +341,61 @@ namespace ob
         mTimeline.append<ssvu::Go>(idx, mTimes - 1);
     }
 
+    // Body user data
+    struct OBTile;
+    class OBCHealth;
+    class OBCProjectile;
+    class OBCPPlate;
+    class OBCPlayer;
+    class OBCForceField;
+    class OBCBulletForceField;
+
+    // Every body created by the game points to one of these records
+    // Collision handlers resolve the components of the other body through
+    // the pre-resolved pointers instead of going through the entity
+    struct OBBodyData
+    {
+        Entity* entity{nullptr};
+        OBTile* tile{nullptr};
+        OBCHealth* cHealth{nullptr};
+        OBCProjectile* cProjectile{nullptr};
+        OBCPPlate* cPPlate{nullptr};
+        OBCPlayer* cPlayer{nullptr};
+        OBCForceField* cForceField{nullptr};
+        OBCBulletForceField* cBulletForceField{nullptr};
+    };
+
     // Other utils
+    inline OBBodyData& getBodyData(Body& mBody)
+    {
+        return *mBody.getUserData<OBBodyData*>();
+    }
     inline Entity& getEntityFromBody(Body& mBody)
     {
-        return *mBody.getUserData<Entity*>();
+        return *getBodyData(mBody).entity;
     }
     template <typename T>
     inline T& getComponentFromBody(Body& mBody)
     {
         return getEntityFromBody(mBody).getComponent<T>();
     }
+
+#define OB_BODYDATA_COMPONENT(mType, mMember)                  \
+    template <>                                                \
+    inline mType& getComponentFromBody<mType>(Body & mBody)    \
+    {                                                          \
+        SSVU_ASSERT(getBodyData(mBody).mMember != nullptr);    \
+        return *getBodyData(mBody).mMember;                    \
+    }
+
+    OB_BODYDATA_COMPONENT(OBCHealth, cHealth)
+    OB_BODYDATA_COMPONENT(OBCProjectile, cProjectile)
+    OB_BODYDATA_COMPONENT(OBCPPlate, cPPlate)
+    OB_BODYDATA_COMPONENT(OBCPlayer, cPlayer)
+    OB_BODYDATA_COMPONENT(OBCForceField, cForceField)
+    OB_BODYDATA_COMPONENT(OBCBulletForceField, cBulletForceField)
+
+#undef OB_BODYDATA_COMPONENT
 }
 
 
@@ -5,6 +5,7 @@
 #ifndef SSVOB_CONFIG
 #define SSVOB_CONFIG
 
+#include <thread>
 #include "SSVBloodshed/OBCommon.hpp"
 
 namespace ob
@@ -26,6 +27,8 @@ namespace ob
         float dmgMultGlobal{1.f}; // Multiplier of damage dealt
         float dmgMultPlayer{1.f}; // Multiplier of damage dealt by the player
         float dmgMultEnemy{1.f};  // Multiplier of damage dealt by the enemies
+        SizeT aiThreads{std::max(1u, std::thread::hardware_concurrency())};
+        SizeT levelCacheKB{16 * 1024}; // Resident levels, before eviction
 
         // SFX
         bool soundEnabled{true}, musicEnabled{true};
@@ -104,6 +107,15 @@ namespace ob
             get().dmgMultEnemy = mX;
         }
 
+        inline static void setAIThreads(SizeT mX) noexcept
+        {
+            get().aiThreads = std::max(SizeT(1), mX);
+        }
+        inline static void setLevelCacheKB(SizeT mX) noexcept
+        {
+            get().levelCacheKB = mX;
+        }
+
         inline static float getDmgMultGlobal() noexcept
         {
             return get().dmgMultGlobal;
@@ -116,6 +128,11 @@ namespace ob
         {
             return get().dmgMultEnemy * getDmgMultGlobal();
         }
+        inline static SizeT getAIThreads() noexcept { return get().aiThreads; }
+        inline static SizeT getLevelCacheKB() noexcept
+        {
+            return get().levelCacheKB;
+        }
 
         // SFX
         inline static void setSoundEnabled(bool mX) noexcept
@@ -149,8 +166,8 @@ SSVJ_CNV_NAMESPACE()
         auto& sfx(mV["sfx"]);
         auto& input(mV["input"]);
 
-        SSVJ_SRLZ_OBJ_AUTO(
-            gameplay, mX, dmgMultGlobal, dmgMultPlayer, dmgMultEnemy);
+        SSVJ_SRLZ_OBJ_AUTO(gameplay, mX, dmgMultGlobal, dmgMultPlayer,
+            dmgMultEnemy, aiThreads, levelCacheKB);
 
         SSVJ_SRLZ_OBJ_AUTO(gfx, mX, particleMult, particleMax);
 
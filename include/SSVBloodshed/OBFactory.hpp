@@ -20,7 +20,6 @@ namespace ob
     class OBCProjectile;
     class OBCKillable;
     class OBParticleSystem;
-    class OBWpnType;
 
     template <typename T, typename TTpl>
     inline constexpr T& gt(const TTpl& mTpl) noexcept
@@ -56,7 +55,7 @@ namespace ob
             const Vec2i& mSize, float mSpeed, float mDeg,
             const sf::IntRect& mIntRect);
         Entity& createETurretBase(const Vec2i& mPos, Dir8 mDir,
-            const sf::IntRect& mIntRect, const OBWpnType& mWpn,
+            const sf::IntRect& mIntRect, OBWpnTypeId mWpn,
             float mShootDelay, float mPJDelay, int mShootCount);
 
     public:
@@ -65,16 +64,20 @@ namespace ob
         {
         }
 
-        Entity& createParticleSystem(sf::RenderTexture& mRenderTexture,
-            bool mClearOnDraw, unsigned char mOpacity, int mDrawPriority,
+        Entity& createParticleSystem(OBParticleSystem& mParticleSystem,
+            sf::RenderTexture& mRenderTexture, bool mClearOnDraw,
+            unsigned char mOpacity, int mDrawPriority,
             sf::BlendMode mBlendMode);
         Entity& createTrail(
-            const Vec2i& mA, const Vec2i& mB, const sf::Color& mColor);
+            const OBCPhys& mSource, int mId, const sf::Color& mColor);
+        Entity& createTileLayer(int mDrawPriority);
+
+        // Floors, pits and walls are tiles of the game's tile layers
+        void createFloor(const Vec2i& mPos, bool mGrate = false);
+        void createPit(const Vec2i& mPos);
+        void createWall(const Vec2i& mPos, const sf::IntRect& mIntRect);
 
-        Entity& createFloor(const Vec2i& mPos, bool mGrate = false);
-        Entity& createPit(const Vec2i& mPos);
         Entity& createTrapdoor(const Vec2i& mPos, bool mPlayerOnly);
-        Entity& createWall(const Vec2i& mPos, const sf::IntRect& mIntRect);
         Entity& createWallDestructible(
             const Vec2i& mPos, const sf::IntRect& mIntRect);
         Entity& createDoor(const Vec2i& mPos, const sf::IntRect& mIntRect,
@@ -84,7 +87,7 @@ namespace ob
         Entity& createDoorR(
             const Vec2i& mPos, const sf::IntRect& mIntRect, bool mOpen);
         Entity& createPPlate(const Vec2i& mPos, int mId, PPlateType mType,
-            IdAction mIdAction, bool mPlayerOnly);
+            IdAction mIdAction, bool mPlayerOnly, int mCluster);
         Entity& createPlayer(const Vec2i& mPos);
         Entity& createExplosiveCrate(const Vec2i& mPos, int mId);
         Entity& createShard(const Vec2i& mPos);
@@ -140,30 +143,12 @@ namespace ob
         Entity& createPJTestShell(
             OBCActorND* mShooter, const Vec2i& mPos, float mDeg);
 
-        template <typename T>
-        inline void deathExplode(
-            OBCActorND* mShooter, T& mTpl, SizeT mCount, float mRangeMult = 1.f)
-        {
-            auto& cp(
-                createPJExplosion(mShooter, gt<OBCPhys>(mTpl).getPosI(), 0, 0)
-                    .template getComponent<OBCProjectile>());
-            cp.setTargetGroup(OBGroup::GKillable);
-            cp.setLife(16.f * mRangeMult);
-            cp.setKillDestructible(true);
-
-            SSVU_ASSERT(mCount != 0);
-            for(int i{0}; i < 360; i += 360 / mCount)
-            {
-                auto& cpMv(createPJExplosion(mShooter,
-                               gt<OBCPhys>(mTpl).getPosI() +
-                                   Vec2i(ssvs::getVecFromDeg(i, 251.f)),
-                               i)
-                               .template getComponent<OBCProjectile>());
-                cpMv.setTargetGroup(OBGroup::GKillable);
-                cpMv.setLife(16.f * mRangeMult);
-                cpMv.setKillDestructible(true);
-            }
-        }
+        void createDeathExplosion(OBCActorND* mShooter, const Vec2i& mPos,
+            SizeT mCount, float mRangeMult = 1.f);
+
+        // Records a death explosion, created after the world update
+        void deathExplode(OBCActorND* mShooter, const Vec2i& mPos,
+            SizeT mCount, float mRangeMult = 1.f);
     };
 }
 
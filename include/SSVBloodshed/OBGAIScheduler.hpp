@@ -0,0 +1,232 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_AISCHEDULER
+#define SSVOB_GAME_AISCHEDULER
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/OBSteering.hpp"
+#include "SSVBloodshed/OBGTargetRegistry.hpp"
+#include "SSVBloodshed/OBGSightGrid.hpp"
+#include "SSVBloodshed/OBGFlowField.hpp"
+
+namespace ob
+{
+    class OBCEBase;
+
+    // Runs enemy AI in three steps every frame:
+    // - `refresh` snapshots every enemy and hands out the frame's decisions
+    //   - only a fixed number of enemies can think per frame, the rest
+    //   reuse their last decision;
+    // - `decide` targets, checks line of sight and takes the decisions on
+    //   the workers, writing one result per enemy;
+    // - enemies apply their result (steering, shooting) serially during the
+    //   manager update.
+    //
+    // Deciding only reads the snapshot and the game's frozen grids, so the
+    // results don't depend on the number of threads
+    class OBGAIScheduler
+    {
+    public:
+        // How an enemy type decides where to go and whether to shoot
+        enum class Mind : int
+        {
+            None,    // Only targets - steers by itself every frame
+            Gunner,  // Shoots when aligned and in sight, chases otherwise
+            Slammer, // Shoots like gunners but not up close - body slams,
+                     // chases or evades once disarmed
+            Kiter    // Pursues from afar and evades within `evadeDist`
+        };
+
+        struct Decision
+        {
+            int slot{OBGTargetRegistry::nullSlot};
+            float dist{0.f};
+            bool inSightRanged{false}, inSightMelee{false}, shooting{false};
+            Vec2f steeringVel;
+            float steeringMult{0.f};
+        };
+
+        struct Agent
+        {
+            Vec2f pos, vel;
+            Vec2i posI;
+            float currentDeg, maxVel, evadeDist;
+            Mind mind;
+            bool armed, thinks;
+            Decision last;
+        };
+
+        // Frozen game state decisions are taken from
+        struct Senses
+        {
+            const OBGTargetRegistry& targets;
+            const OBGSightGrid& sight;
+            const OBGFlowField& flow;
+        };
+
+    private:
+        static constexpr int thinkBudget{64};
+
+        // Enemies that waited this long think regardless of the budget, so
+        // that no enemy starves in crowded rooms
+        static constexpr FT maxThinkWait{12.f};
+
+        std::vector<OBCEBase*> members;
+        std::vector<Agent> agents;
+        std::vector<Decision> decisions;
+
+    public:
+        // Removing swaps the last member into the freed slot - the snapshot
+        // is untouched, as members keep their snapshot index until the next
+        // refresh
+        void add(OBCEBase& mMember);
+        void remove(OBCEBase& mMember);
+
+        // Takes the snapshot, assigns every member its index in it and
+        // hands out the frame's decisions
+        void refresh(FT mFT);
+
+        inline void decide(const Senses& mSenses, OBWorkers& mWorkers)
+        {
+            decide(agents, decisions, mSenses, mWorkers);
+        }
+
+        inline bool isThinking(int mIdx) const noexcept
+        {
+            return agents[mIdx].thinks;
+        }
+        inline const Decision& getDecision(int mIdx) const noexcept
+        {
+            return decisions[mIdx];
+        }
+
+        // Frames to wait before the next decision: enemies that see the
+        // player up close think every frame, distant or hidden ones rarely
+        inline static FT getThinkDelay(float mDist, bool mVisible) noexcept
+        {
+            if(mVisible && mDist < 12000.f) return 0.f;
+            if(mDist < 25000.f) return mVisible ? 2.f : 4.f;
+            return 8.f;
+        }
+
+        // Targets every agent, and takes a new decision for the thinking
+        // ones - the others keep their last one
+        inline static Decision decide(const Agent& mA, const Senses& mS)
+        {
+            constexpr float distBodySlam{2750.f}, distEvade{10000.f};
+
+            Decision d(mA.last);
+            d.slot = mS.targets.getNearest(mA.pos);
+            if(d.slot == OBGTargetRegistry::nullSlot) return d;
+
+            const auto& t(mS.targets[d.slot]);
+            d.dist = ssvs::getDistEuclidean(t.posF, mA.pos);
+            if(!mA.thinks || mA.mind == Mind::None) return d;
+
+            d.inSightRanged = mS.sight.isInSight(mA.posI, t.posI, true, false);
+            d.inSightMelee = mS.sight.isInSight(mA.posI, t.posI, false, true);
+            auto degDiff(ssvu::getDistDeg(
+                mA.currentDeg, ssvs::getDegTowards(mA.pos, t.posF)));
+
+            auto steer([&d](const Vec2f& mVel)
+                {
+                    d.steeringVel = mVel;
+                    d.steeringMult = 0.02f;
+                });
+            auto pursuit([&mA, &t, &steer]
+                {
+                    steer(OBSteering::getPursuitVel(
+                        mA.pos, t.posF, t.vel, mA.maxVel, 1.f, 1500.f));
+                });
+            auto evade([&mA, &t, &steer]
+                {
+                    steer(OBSteering::getEvadeVel(
+                        mA.pos, t.posF, t.vel, mA.maxVel));
+                });
+
+            // Ground enemies walk the flow field around walls and pits, and
+            // pursue directly once close or when the field has no route
+            auto chase([&mA, &mS, &d, &steer, &pursuit]
+                {
+                    const auto& dir(mS.flow.getDir(mA.posI));
+                    if(d.dist < 2000.f || dir == ssvs::zeroVec2f)
+                        pursuit();
+                    else
+                        steer(dir * mA.maxVel);
+                });
+
+            // Gunners close in, then keep aligned behind their gun
+            auto pursuitOrAlign([&mA, &t, &d, &steer, &pursuit](float mDist)
+                {
+                    if(d.dist > mDist)
+                    {
+                        pursuit();
+                        return;
+                    }
+
+                    auto aimDeg(getDegFromDir8(getDir8FromDeg(mA.currentDeg)));
+                    steer(OBSteering::getSeekVel(mA.pos,
+                        ssvs::getOrbitDeg(t.posF, aimDeg + 180, mDist),
+                        mA.maxVel, 750.f));
+                });
+
+            d.shooting = false;
+            d.steeringVel = ssvs::zeroVec2f;
+            d.steeringMult = 0.f;
+
+            switch(mA.mind)
+            {
+                case Mind::None: break;
+                case Mind::Gunner:
+                    d.shooting =
+                        mA.armed && degDiff < 50.f && d.inSightRanged;
+                    if(d.shooting)
+                        pursuitOrAlign(9000.f);
+                    else
+                        chase();
+                    break;
+                case Mind::Slammer:
+                    d.shooting = mA.armed && degDiff < 50.f &&
+                                 d.inSightRanged && d.dist > distBodySlam;
+                    if(d.shooting)
+                        pursuitOrAlign(distEvade - 1000.f);
+                    else if(!mA.armed)
+                    {
+                        if(d.dist < distBodySlam)
+                            pursuit();
+                        else if(d.dist > distEvade)
+                            chase();
+                        else
+                            evade();
+                    }
+                    break;
+                case Mind::Kiter:
+                    if(d.dist > mA.evadeDist)
+                        pursuit();
+                    else
+                        evade();
+                    break;
+            }
+
+            return d;
+        }
+
+        inline static void decide(const std::vector<Agent>& mAgents,
+            std::vector<Decision>& mOut, const Senses& mSenses,
+            OBWorkers& mWorkers)
+        {
+            mOut.resize(mAgents.size());
+            mWorkers.forRanges(mAgents.size(), [&mAgents, &mOut, &mSenses](
+                                                   SizeT mBegin, SizeT mEnd)
+                {
+                    for(auto i(mBegin); i < mEnd; ++i)
+                        mOut[i] = decide(mAgents[i], mSenses);
+                });
+        }
+    };
+}
+
+#endif
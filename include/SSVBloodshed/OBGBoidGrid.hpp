@@ -0,0 +1,203 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_BOIDGRID
+#define SSVOB_GAME_BOIDGRID
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+
+namespace ob
+{
+    class OBCBoid;
+
+    // Uniform grid of boid positions, rebuilt by the game once per frame
+    // with a counting sort - neighbor lookups only visit the 3x3 cells
+    // around the querying boid and never touch the collision world
+    //
+    // The snapshot is frozen for the rest of the frame, so the flocking
+    // steering of every boid is decided in parallel from it and then
+    // applied serially by the boids themselves
+    class OBGBoidGrid
+    {
+    public:
+        struct Entry
+        {
+            SizeT idx;
+            Vec2f pos;
+        };
+        struct Neighbor
+        {
+            const Entry* entry;
+            float dist;
+        };
+
+        // Snapshot of a boid's state and flocking parameters
+        struct Agent
+        {
+            Vec2f pos, vel;
+            float maxVel, neighborRadius, separationMult, cohesionMult;
+        };
+
+        static constexpr int cellSize{2000};
+        static constexpr SizeT maxNeighbors{6};
+        using Neighbors = std::array<Neighbor, maxNeighbors>;
+
+    private:
+        static constexpr int cols{levelWidthCoords / cellSize + 1};
+        static constexpr int rows{levelHeightCoords / cellSize + 1};
+
+        std::vector<OBCBoid*> members;
+        std::vector<Agent> agents;
+        std::vector<Entry> entries;
+        std::array<SizeT, cols * rows + 1> cellStarts;
+        std::vector<int> entryCells;
+        std::vector<Vec2f> steerings;
+
+        inline static int getCell(int mX, int mY) noexcept
+        {
+            return ssvu::getClamped(mX, 0, cols - 1) +
+                   ssvu::getClamped(mY, 0, rows - 1) * cols;
+        }
+        inline static int getCell(const Vec2f& mPos) noexcept
+        {
+            return getCell(int(mPos.x) / cellSize, int(mPos.y) / cellSize);
+        }
+
+        // Counting sort of the agents into their cells
+        inline void sortAgents()
+        {
+            cellStarts.fill(0);
+            entries.resize(agents.size());
+            entryCells.resize(agents.size());
+
+            // Count agents per cell, then turn the counts into start offsets
+            for(auto i(0u); i < agents.size(); ++i)
+            {
+                entryCells[i] = getCell(agents[i].pos);
+                ++cellStarts[entryCells[i] + 1];
+            }
+            for(auto i(1u); i < cellStarts.size(); ++i)
+                cellStarts[i] += cellStarts[i - 1];
+
+            // Scatter the agents into their cells' ranges
+            auto cursors(cellStarts);
+            for(auto i(0u); i < agents.size(); ++i)
+                entries[cursors[entryCells[i]]++] = {i, agents[i].pos};
+        }
+
+        inline Vec2f getFlockSteering(SizeT mIdx, Neighbors& mNeighbors) const
+        {
+            const auto& a(agents[mIdx]);
+            auto count(getNearest(mIdx, a.pos, a.neighborRadius, mNeighbors));
+            if(count == 0) return ssvs::zeroVec2f;
+
+            // Separation pushes away harder the closer the neighbor is
+            Vec2f separation, centroid;
+            for(auto i(0u); i < count; ++i)
+            {
+                const auto& n(mNeighbors[i]);
+                centroid += n.entry->pos;
+                if(n.dist > 0.f)
+                    separation += (a.pos - n.entry->pos) *
+                                  ((1.f - n.dist / a.neighborRadius) / n.dist);
+            }
+            centroid /= float(count);
+
+            // Cohesion seeks the neighbors' centroid, slowing down near it
+            Vec2f toCentroid{centroid - a.pos};
+            auto dist(ssvs::getMag(toCentroid));
+            ssvs::resize(toCentroid, dist <= a.neighborRadius
+                                         ? a.maxVel * dist / a.neighborRadius
+                                         : a.maxVel);
+
+            return separation * (a.maxVel * a.separationMult) +
+                   (toCentroid - a.vel) * a.cohesionMult;
+        }
+
+    public:
+        inline void add(OBCBoid& mBoid) { members.emplace_back(&mBoid); }
+        inline void remove(OBCBoid& mBoid)
+        {
+            ssvu::eraseRemove(members, &mBoid);
+        }
+
+        // Takes the snapshot and assigns every member its index in it
+        void refresh();
+
+        // Takes a snapshot of agents that aren't backed by boids
+        inline void refresh(std::vector<Agent> mAgents)
+        {
+            agents = ssvu::mv(mAgents);
+            sortAgents();
+        }
+
+        // Computes the flocking steering of every boid in the snapshot -
+        // only reads the snapshot, so the result doesn't depend on the
+        // number of threads
+        inline void decide(OBWorkers& mWorkers)
+        {
+            steerings.resize(agents.size());
+            mWorkers.forRanges(agents.size(), [this](SizeT mBegin, SizeT mEnd)
+                {
+                    Neighbors neighbors;
+                    for(auto i(mBegin); i < mEnd; ++i)
+                        steerings[i] = getFlockSteering(i, neighbors);
+                });
+        }
+
+        inline const Vec2f& getSteering(int mIdx) const noexcept
+        {
+            return steerings[mIdx];
+        }
+
+        // Fills `mOut` with up to `maxNeighbors` agents closest to `mPos`
+        // within `mRadius`, skipping the agent `mSelf` and returning how
+        // many were found - positions outside of the level are clamped to
+        // its edge cells, like the agents stored there
+        inline SizeT getNearest(SizeT mSelf, const Vec2f& mPos, float mRadius,
+            Neighbors& mOut) const noexcept
+        {
+            SSVU_ASSERT(mRadius <= cellSize);
+
+            SizeT count{0};
+            auto cx(ssvu::getClamped(int(mPos.x) / cellSize, 0, cols - 1));
+            auto cy(ssvu::getClamped(int(mPos.y) / cellSize, 0, rows - 1));
+
+            for(int y{cy - 1}; y <= cy + 1; ++y)
+            {
+                if(y < 0 || y >= rows) continue;
+
+                for(int x{cx - 1}; x <= cx + 1; ++x)
+                {
+                    if(x < 0 || x >= cols) continue;
+
+                    auto cell(getCell(x, y));
+                    for(auto i(cellStarts[cell]); i < cellStarts[cell + 1];
+                        ++i)
+                    {
+                        const auto& e(entries[i]);
+                        if(e.idx == mSelf) continue;
+
+                        auto dist(ssvs::getDistEuclidean(e.pos, mPos));
+                        if(dist > mRadius) continue;
+                        if(count == maxNeighbors &&
+                            dist >= mOut[count - 1].dist)
+                            continue;
+
+                        // Insertion into the sorted fixed-size array
+                        auto j(count < maxNeighbors ? count++ : count - 1);
+                        for(; j > 0 && mOut[j - 1].dist > dist; --j)
+                            mOut[j] = mOut[j - 1];
+                        mOut[j] = {&e, dist};
+                    }
+                }
+            }
+
+            return count;
+        }
+    };
+}
+
+#endif
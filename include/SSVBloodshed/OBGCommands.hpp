@@ -0,0 +1,114 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_COMMANDS
+#define SSVOB_GAME_COMMANDS
+
+#include <thread>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    class OBGame;
+    class OBCActorND;
+
+    // Structural changes requested during entity updates and collision
+    // callbacks - the game applies them all after the world update
+    //
+    // Commands are only recorded on the main thread, by the serial manager
+    // and world updates, so recording order already follows the entity and
+    // body update order and is the same on every run - no sort key is
+    // needed to apply them deterministically
+    class OBGCommands
+    {
+    public:
+        struct ChangeLevel
+        {
+            int x, y;
+            OBPlayerData playerData;
+        };
+        struct Explode
+        {
+            OBCActorND* shooter;
+            Vec2i pos;
+            SizeT count;
+            float rangeMult;
+        };
+        struct SpawnEBall
+        {
+            Vec2i pos;
+            Vec2f vel;
+            BallType type;
+        };
+        struct SpawnShards
+        {
+            Vec2i pos;
+            SizeT count;
+        };
+
+    private:
+        static constexpr SizeT reservedCount{64};
+
+        bool levelChangePending{false};
+        ChangeLevel levelChange;
+        std::vector<Explode> explosions;
+        std::vector<SpawnEBall> eBallSpawns;
+        std::vector<SpawnShards> shardSpawns;
+        std::thread::id owner{std::this_thread::get_id()};
+
+        inline void checkThread() const noexcept
+        {
+            SSVU_ASSERT(std::this_thread::get_id() == owner);
+        }
+
+    public:
+        inline OBGCommands()
+        {
+            explosions.reserve(reservedCount);
+            eBallSpawns.reserve(reservedCount);
+            shardSpawns.reserve(reservedCount);
+        }
+
+        // Only the first level change recorded in a frame is applied
+        inline void changeLevel(int mX, int mY, const OBPlayerData& mData)
+        {
+            checkThread();
+            if(levelChangePending) return;
+            levelChangePending = true;
+            levelChange = {mX, mY, mData};
+        }
+        inline void explode(OBCActorND* mShooter, const Vec2i& mPos,
+            SizeT mCount, float mRangeMult)
+        {
+            checkThread();
+            explosions.push_back({mShooter, mPos, mCount, mRangeMult});
+        }
+        inline void spawnEBall(
+            const Vec2i& mPos, const Vec2f& mVel, BallType mType)
+        {
+            checkThread();
+            eBallSpawns.push_back({mPos, mVel, mType});
+        }
+        inline void spawnShards(const Vec2i& mPos, SizeT mCount)
+        {
+            checkThread();
+            shardSpawns.push_back({mPos, mCount});
+        }
+
+        inline void clear() noexcept
+        {
+            levelChangePending = false;
+            explosions.clear();
+            eBallSpawns.clear();
+            shardSpawns.clear();
+        }
+
+        // Applies the level change first (a reload discards everything
+        // else), then explosions, enemy spawns and shards, each in recording
+        // order
+        void apply(OBGame& mGame);
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_FLOWFIELD
+#define SSVOB_GAME_FLOWFIELD
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Breadth-first distance field over the level tiles, flowing toward the
+    // target cell (the player) - rebuilt only when the target changes cell
+    // or a cell gets blocked/unblocked, then read by every enemy in O(1)
+    class OBGFlowField
+    {
+    private:
+        static constexpr int cellCount{levelCols * levelRows};
+        static constexpr int unreachable{std::numeric_limits<int>::max()};
+
+        std::array<int, cellCount> blockers, dists;
+        std::array<Vec2f, cellCount> dirs;
+        std::vector<int> queue;
+        int targetIdx{-1};
+        bool dirty{true};
+
+        inline static bool isValid(int mX, int mY) noexcept
+        {
+            return mX >= 0 && mY >= 0 && mX < levelCols && mY < levelRows;
+        }
+        inline static int getIdx(int mX, int mY) noexcept
+        {
+            return mX + mY * levelCols;
+        }
+        inline static int getIdx(const Vec2i& mPos) noexcept
+        {
+            auto x(mPos.x / toCoords(tileSize)), y(mPos.y / toCoords(tileSize));
+            return isValid(x, y) ? getIdx(x, y) : -1;
+        }
+        inline bool isOpen(int mX, int mY) const noexcept
+        {
+            return isValid(mX, mY) && blockers[getIdx(mX, mY)] == 0;
+        }
+
+        inline void rebuild()
+        {
+            dists.fill(unreachable);
+            dirs.fill(ssvs::zeroVec2f);
+            if(targetIdx == -1) return;
+
+            queue.clear();
+            dists[targetIdx] = 0;
+            queue.emplace_back(targetIdx);
+
+            for(auto i(0u); i < queue.size(); ++i)
+            {
+                auto idx(queue[i]);
+                int x{idx % levelCols}, y{idx / levelCols};
+
+                for(const auto& o : {Vec2i{1, 0}, Vec2i{-1, 0}, Vec2i{0, 1},
+                        Vec2i{0, -1}})
+                {
+                    if(!isOpen(x + o.x, y + o.y)) continue;
+
+                    auto nIdx(getIdx(x + o.x, y + o.y));
+                    if(dists[nIdx] != unreachable) continue;
+
+                    dists[nIdx] = dists[idx] + 1;
+                    queue.emplace_back(nIdx);
+                }
+            }
+
+            // Every reachable cell points to its closest neighbor, diagonals
+            // included unless they would cut a blocked corner
+            for(int y{0}; y < levelRows; ++y)
+                for(int x{0}; x < levelCols; ++x)
+                {
+                    auto idx(getIdx(x, y));
+                    if(dists[idx] == unreachable || dists[idx] == 0) continue;
+
+                    auto best(dists[idx]);
+                    Vec2i bestOffset;
+
+                    for(int i{0}; i < 8; ++i)
+                    {
+                        auto o(getVecFromDir8(Dir8(i)));
+                        if(!isOpen(x + o.x, y + o.y)) continue;
+                        if(o.x != 0 && o.y != 0 &&
+                            (!isOpen(x + o.x, y) || !isOpen(x, y + o.y)))
+                            continue;
+
+                        auto nDist(dists[getIdx(x + o.x, y + o.y)]);
+                        if(nDist < best)
+                        {
+                            best = nDist;
+                            bestOffset = o;
+                        }
+                    }
+
+                    dirs[idx] = ssvs::getNormalized(Vec2f(bestOffset));
+                }
+        }
+
+    public:
+        inline OBGFlowField()
+        {
+            queue.reserve(cellCount);
+            clear();
+        }
+
+        inline void clear() noexcept
+        {
+            blockers.fill(0);
+            targetIdx = -1;
+            dirty = true;
+        }
+
+        // Walls, pits and closed doors block the cell they're in
+        inline void addBlocker(const Vec2i& mPos) noexcept
+        {
+            auto idx(getIdx(mPos));
+            if(idx == -1) return;
+            if(blockers[idx]++ == 0) dirty = true;
+        }
+        inline void removeBlocker(const Vec2i& mPos) noexcept
+        {
+            auto idx(getIdx(mPos));
+            if(idx == -1 || blockers[idx] == 0) return;
+            if(--blockers[idx] == 0) dirty = true;
+        }
+
+        inline void setTarget(const Vec2i& mPos) noexcept
+        {
+            auto idx(getIdx(mPos));
+            if(idx == targetIdx) return;
+            targetIdx = idx;
+            dirty = true;
+        }
+
+        // Called once per frame by the game
+        inline void refresh()
+        {
+            if(!dirty) return;
+            dirty = false;
+            rebuild();
+        }
+
+        // Normalized direction toward the target - zero in the target cell
+        // and in cells that can't reach it
+        inline const Vec2f& getDir(const Vec2i& mPos) const noexcept
+        {
+            auto idx(getIdx(mPos));
+            return idx == -1 ? ssvs::zeroVec2f : dirs[idx];
+        }
+        inline bool isReachable(const Vec2i& mPos) const noexcept
+        {
+            auto idx(getIdx(mPos));
+            return idx != -1 && dists[idx] != unreachable;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_IDLINKS
+#define SSVOB_GAME_IDLINKS
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    class OBCPhys;
+    class OBCIdReceiver;
+    class OBCTrail;
+    class OBCPPlate;
+
+    // Id -> receivers index, filled by the receivers themselves as the
+    // level spawns them and emptied as they die - activating an id only
+    // visits its own receivers
+    //
+    // Every (source, id) pair also has at most one live trail, which gets
+    // restarted instead of duplicated when the source fires again
+    //
+    // Pressure plates register in the cluster they were baked into, so that
+    // they find the rest of it without querying the world
+    class OBGIdLinks
+    {
+    private:
+        using TrailKey = std::pair<const OBCPhys*, int>;
+
+        std::unordered_map<int, std::vector<OBCIdReceiver*>> receivers;
+        std::map<TrailKey, OBCTrail*> trails;
+        std::vector<std::vector<OBCPPlate*>> plateClusters;
+
+    public:
+        inline void add(OBCIdReceiver& mReceiver, int mId)
+        {
+            if(mId != -1) receivers[mId].emplace_back(&mReceiver);
+        }
+        inline void remove(OBCIdReceiver& mReceiver, int mId)
+        {
+            auto itr(receivers.find(mId));
+            if(itr != std::end(receivers))
+                ssvu::eraseRemove(itr->second, &mReceiver);
+        }
+
+        // Sizes the tables from a baked level before spawning it
+        inline void reserve(int mId, SizeT mReceiverCount)
+        {
+            if(mId != -1) receivers[mId].reserve(mReceiverCount);
+        }
+        inline void setPlateClusterCount(SizeT mCount)
+        {
+            plateClusters.resize(mCount);
+        }
+
+        inline void addPlate(OBCPPlate& mPlate, int mCluster)
+        {
+            if(mCluster < 0) return;
+            if(SizeT(mCluster) >= plateClusters.size())
+                plateClusters.resize(mCluster + 1);
+            plateClusters[mCluster].emplace_back(&mPlate);
+        }
+        inline void removePlate(OBCPPlate& mPlate, int mCluster)
+        {
+            if(mCluster >= 0 && SizeT(mCluster) < plateClusters.size())
+                ssvu::eraseRemove(plateClusters[mCluster], &mPlate);
+        }
+        inline const std::vector<OBCPPlate*>& getPlates(int mCluster) const
+        {
+            static std::vector<OBCPPlate*> none;
+            if(mCluster < 0 || SizeT(mCluster) >= plateClusters.size())
+                return none;
+            return plateClusters[mCluster];
+        }
+
+        inline void addTrail(const OBCPhys& mSource, int mId, OBCTrail& mTrail)
+        {
+            trails[{&mSource, mId}] = &mTrail;
+        }
+        inline void removeTrail(
+            const OBCPhys* mSource, int mId, const OBCTrail& mTrail)
+        {
+            // The pair might already belong to a newer trail
+            auto itr(trails.find({mSource, mId}));
+            if(itr != std::end(trails) && itr->second == &mTrail)
+                trails.erase(itr);
+        }
+
+        inline void clear()
+        {
+            receivers.clear();
+            trails.clear();
+            plateClusters.clear();
+        }
+
+        // Activates every receiver listening to `mId`, linking them to
+        // `mSource` with a trail
+        void activate(OBCPhys& mSource, int mId, IdAction mIdAction);
+    };
+}
+
+#endif
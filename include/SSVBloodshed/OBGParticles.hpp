@@ -17,9 +17,10 @@ namespace ob
         static constexpr unsigned int txWidth{levelWidthPx};
         static constexpr unsigned int txHeight{levelHeightPx};
         sf::RenderTexture txPSPerm, txPSTemp;
-        OBParticleSystem* psPerm{nullptr};
-        OBParticleSystem* psTemp{nullptr};
-        OBParticleSystem* psTempAdd{nullptr};
+
+        // The systems (and their vertex buffers) live as long as the game -
+        // only the drawing entities are recreated for every level
+        OBParticleSystem psPerm, psTemp, psTempAdd;
 
     public:
         inline OBGParticles()
@@ -30,23 +31,21 @@ namespace ob
 
         inline void clear(OBFactory& mFactory)
         {
-            psPerm = &mFactory.createParticleSystem(txPSPerm, false, 175,
-                                  OBLayer::LPSPerm, sf::BlendAlpha)
-                          .getComponent<OBCParticleSystem>()
-                          .getParticleSystem();
-            psTemp = &mFactory.createParticleSystem(txPSTemp, true, 255,
-                                  OBLayer::LPSTemp, sf::BlendAlpha)
-                          .getComponent<OBCParticleSystem>()
-                          .getParticleSystem();
-            psTempAdd = &mFactory.createParticleSystem(txPSTemp, true, 255,
-                                     OBLayer::LPSTemp, sf::BlendAdd)
-                             .getComponent<OBCParticleSystem>()
-                             .getParticleSystem();
+            psPerm.clear();
+            psTemp.clear();
+            psTempAdd.clear();
+
+            mFactory.createParticleSystem(psPerm, txPSPerm, false, 175,
+                OBLayer::LPSPerm, sf::BlendAlpha);
+            mFactory.createParticleSystem(psTemp, txPSTemp, true, 255,
+                OBLayer::LPSTemp, sf::BlendAlpha);
+            mFactory.createParticleSystem(psTempAdd, txPSTemp, true, 255,
+                OBLayer::LPSTemp, sf::BlendAdd);
         }
 
-        inline OBParticleSystem& getPSPerm() noexcept { return *psPerm; }
-        inline OBParticleSystem& getPSTemp() noexcept { return *psTemp; }
-        inline OBParticleSystem& getPSTempAdd() noexcept { return *psTempAdd; }
+        inline OBParticleSystem& getPSPerm() noexcept { return psPerm; }
+        inline OBParticleSystem& getPSTemp() noexcept { return psTemp; }
+        inline OBParticleSystem& getPSTempAdd() noexcept { return psTempAdd; }
     };
 }
 
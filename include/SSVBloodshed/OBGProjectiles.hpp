@@ -0,0 +1,70 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_PROJECTILES
+#define SSVOB_GAME_PROJECTILES
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    class OBCProjectile;
+
+    // Flight state of every live projectile, kept in flat arrays and
+    // advanced by the game in a single pass once per frame - projectiles
+    // keep their index into the store and read and write their state
+    // through it
+    class OBGProjectiles
+    {
+    public:
+        struct Flight
+        {
+            float acceleration{0.f}, minSpeed{0.f}, maxSpeed{1000.f},
+                curveSpeed{0.f};
+        };
+        struct Life
+        {
+            float current{0.f}, max{150.f};
+        };
+
+    private:
+        std::vector<OBCProjectile*> members;
+        std::vector<Flight> flights;
+        std::vector<Life> lives;
+        std::vector<std::uint8_t> alive;
+        std::vector<Vec2f> velocities;
+        std::vector<SizeT> expired;
+
+    public:
+        // A removed projectile is swapped with the last one and popped
+        // from every array
+        void add(OBCProjectile& mProjectile);
+        void remove(OBCProjectile& mProjectile);
+
+        // Grows the store once for a whole volley of `mCount` projectiles
+        inline void reserve(SizeT mCount)
+        {
+            auto size(members.size() + mCount);
+            members.reserve(size);
+            flights.reserve(size);
+            lives.reserve(size);
+            alive.reserve(size);
+        }
+
+        // Steers and ages every live projectile, then destroys the expired
+        // ones - projectiles they spawn on destruction join the next update
+        void update(FT mFT);
+
+        // Projectiles that were destroyed are skipped until the manager
+        // removes them
+        inline void kill(SizeT mIdx) noexcept { alive[mIdx] = false; }
+
+        inline Flight& getFlight(SizeT mIdx) noexcept { return flights[mIdx]; }
+        inline Life& getLife(SizeT mIdx) noexcept { return lives[mIdx]; }
+
+        inline SizeT getCount() const noexcept { return members.size(); }
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_SHARDS
+#define SSVOB_GAME_SHARDS
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    class OBCShard;
+
+    // Compact snapshot of every live shard, taken by the game once per
+    // frame - shards at rest merge into clumps worth the sum of their
+    // values, and player attraction is computed in a single pass over the
+    // snapshot's flat arrays
+    class OBGShards
+    {
+    public:
+        static constexpr float restSpeed{30.f};
+        static constexpr float mergeDist{600.f};
+        static constexpr int maxValue{16};
+
+    private:
+        enum class Pull : std::uint8_t
+        {
+            None,
+            Accel,
+            Vel
+        };
+
+        std::vector<OBCShard*> members;
+        std::vector<Vec2f> positions, velocities, pulls;
+        std::vector<Pull> pullTypes;
+        std::vector<SizeT> resting;
+
+        void merge();
+
+    public:
+        // Keeps the snapshot in step with `members`: a shard added mid-frame
+        // is snapshotted right away, and a removed one is swapped with the
+        // last shard and popped from every array
+        void add(OBCShard& mShard);
+        void remove(OBCShard& mShard);
+
+        // Takes the snapshot and merges the shards that came to rest near
+        // each other - merged shards are destroyed with the next manager
+        // refresh
+        void refresh();
+
+        // Pulls every shard toward `mPos` - once the level is clear shards
+        // ignore walls and home in from anywhere in the room
+        void attract(const Vec2i& mPos, bool mLevelClear);
+
+        inline SizeT getCount() const noexcept { return members.size(); }
+    };
+}
+
+#endif
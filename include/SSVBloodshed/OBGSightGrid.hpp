@@ -0,0 +1,144 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_SIGHTGRID
+#define SSVOB_GAME_SIGHTGRID
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Level tiles that block enemy line of sight, kept up to date as they
+    // change like the flow field's blockers - sight checks walk the tiles
+    // crossed by the ray and never touch the collision world, so they can
+    // run on every worker at once
+    class OBGSightGrid
+    {
+    private:
+        // Force fields block sight coming from their front half only
+        struct Field
+        {
+            int idx;
+            float rad;
+            bool bullet;
+        };
+
+        static constexpr int cellCount{levelCols * levelRows};
+
+        std::array<int, cellCount> blockers, fieldCounts;
+        std::vector<Field> fields;
+
+        inline static bool isValid(int mX, int mY) noexcept
+        {
+            return mX >= 0 && mY >= 0 && mX < levelCols && mY < levelRows;
+        }
+        inline static int getIdx(int mX, int mY) noexcept
+        {
+            return mX + mY * levelCols;
+        }
+        inline static int getIdx(const Vec2i& mPos) noexcept
+        {
+            auto x(mPos.x / toCoords(tileSize)), y(mPos.y / toCoords(tileSize));
+            return isValid(x, y) ? getIdx(x, y) : -1;
+        }
+
+        inline bool isBlocked(int mIdx, float mRad, bool mBulletFields,
+            bool mFields) const noexcept
+        {
+            if(blockers[mIdx] > 0) return true;
+            if(fieldCounts[mIdx] == 0) return false;
+
+            for(const auto& f : fields)
+                if(f.idx == mIdx && (f.bullet ? mBulletFields : mFields) &&
+                    ssvu::getDistRad(mRad, f.rad) <= ssvu::piHalf)
+                    return true;
+
+            return false;
+        }
+
+    public:
+        inline OBGSightGrid() { clear(); }
+
+        inline void clear() noexcept
+        {
+            blockers.fill(0);
+            fieldCounts.fill(0);
+            fields.clear();
+        }
+
+        // Walls, closed doors, crates and vending machines block the cell
+        // they're in
+        inline void addBlocker(const Vec2i& mPos) noexcept
+        {
+            auto idx(getIdx(mPos));
+            if(idx != -1) ++blockers[idx];
+        }
+        inline void removeBlocker(const Vec2i& mPos) noexcept
+        {
+            auto idx(getIdx(mPos));
+            if(idx != -1 && blockers[idx] > 0) --blockers[idx];
+        }
+
+        // Force fields stay for the whole level, so they're only cleared
+        // with it
+        inline void addField(const Vec2i& mPos, float mRad, bool mBullet)
+        {
+            auto idx(getIdx(mPos));
+            if(idx == -1) return;
+            fields.emplace_back(Field{idx, mRad, mBullet});
+            ++fieldCounts[idx];
+        }
+
+        // Whether a ray from `mFrom` reaches the cell of `mTo` - the cells
+        // of both ends never block, and bullet force fields or force fields
+        // only block if asked to
+        inline bool isInSight(const Vec2i& mFrom, const Vec2i& mTo,
+            bool mBulletFields, bool mFields) const noexcept
+        {
+            constexpr int cell{toCoords(tileSize)};
+            constexpr float inf{std::numeric_limits<float>::max()};
+
+            int x{mFrom.x / cell}, y{mFrom.y / cell};
+            int toX{mTo.x / cell}, toY{mTo.y / cell};
+            if(!isValid(x, y) || !isValid(toX, toY)) return false;
+
+            Vec2f dir(mTo - mFrom);
+            auto rad(ssvs::getRad(dir));
+
+            // Cell traversal in the order the ray crosses the cells
+            int stepX{dir.x > 0 ? 1 : -1}, stepY{dir.y > 0 ? 1 : -1};
+            float nextX{dir.x == 0 ? inf
+                                   : ((x + (stepX > 0)) * cell - mFrom.x) /
+                                         dir.x},
+                nextY{dir.y == 0 ? inf
+                                 : ((y + (stepY > 0)) * cell - mFrom.y) /
+                                       dir.y};
+            float deltaX{dir.x == 0 ? inf : cell / std::abs(dir.x)},
+                deltaY{dir.y == 0 ? inf : cell / std::abs(dir.y)};
+
+            while(x != toX || y != toY)
+            {
+                if(nextX < nextY)
+                {
+                    x += stepX;
+                    nextX += deltaX;
+                }
+                else
+                {
+                    y += stepY;
+                    nextY += deltaY;
+                }
+
+                if(!isValid(x, y)) return false;
+                if(x == toX && y == toY) return true;
+                if(isBlocked(getIdx(x, y), rad, mBulletFields, mFields))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_TARGETREGISTRY
+#define SSVOB_GAME_TARGETREGISTRY
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    class OBCPhys;
+
+    // Snapshot of the entities enemies can target (the players), refreshed
+    // by the game once per frame - targeters keep a slot index into it
+    // instead of querying the manager themselves
+    class OBGTargetRegistry
+    {
+    public:
+        struct Slot
+        {
+            OBCPhys* cPhys;
+            sses::EntityStat stat;
+            Vec2i posI;
+            Vec2f posF, vel;
+            bool alive;
+        };
+
+        static constexpr int nullSlot{-1};
+
+    private:
+        std::vector<Slot> slots;
+
+    public:
+        inline void clear() noexcept { slots.clear(); }
+
+        // Slots are stable while their entity is alive - a dead player's
+        // slot is reused by the next player that joins
+        void refresh(sses::Manager& mManager);
+
+        // Replaces the snapshot - for headless tools, which have no manager
+        inline void assign(std::vector<Slot> mSlots) noexcept
+        {
+            slots = ssvu::mv(mSlots);
+        }
+
+        inline bool isAlive(int mSlot) const noexcept
+        {
+            return mSlot != nullSlot && slots[mSlot].alive;
+        }
+        inline const Slot& operator[](int mSlot) const noexcept
+        {
+            SSVU_ASSERT(mSlot >= 0 && mSlot < int(slots.size()));
+            return slots[mSlot];
+        }
+
+        inline int getNearest(const Vec2f& mPos) const noexcept
+        {
+            int result{nullSlot};
+            float bestDist{std::numeric_limits<float>::max()};
+
+            for(auto i(0u); i < slots.size(); ++i)
+            {
+                if(!slots[i].alive) continue;
+
+                auto dist(ssvs::getDistEuclidean(slots[i].posF, mPos));
+                if(dist >= bestDist) continue;
+
+                bestDist = dist;
+                result = i;
+            }
+
+            return result;
+        }
+    };
+}
+
+#endif
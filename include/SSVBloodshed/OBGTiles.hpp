@@ -0,0 +1,56 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_GAME_TILES
+#define SSVOB_GAME_TILES
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBFactory.hpp"
+#include "SSVBloodshed/Components/OBCTileLayer.hpp"
+
+namespace ob
+{
+    class OBGTiles
+    {
+    private:
+        OBCTileLayer* lFloor{nullptr};
+        OBCTileLayer* lFloorGrate{nullptr};
+        OBCTileLayer* lPit{nullptr};
+        OBCTileLayer* lWall{nullptr};
+
+        inline OBCTileLayer& createLayer(
+            OBFactory& mFactory, OBLayer mLayer)
+        {
+            return mFactory.createTileLayer(mLayer)
+                .getComponent<OBCTileLayer>();
+        }
+
+    public:
+        inline void clear(OBFactory& mFactory)
+        {
+            lFloor = &createLayer(mFactory, OBLayer::LFloor);
+            lFloorGrate = &createLayer(mFactory, OBLayer::LFloorGrate);
+            lPit = &createLayer(mFactory, OBLayer::LPit);
+            lWall = &createLayer(mFactory, OBLayer::LWall);
+        }
+
+        // Moves a floor tile's quad to the grate layer - returns false if it
+        // was already smashed
+        inline bool smashFloor(OBTile& mTile, const sf::IntRect& mGrateRect)
+        {
+            if(mTile.smashed) return false;
+            mTile.smashed = true;
+            lFloor->hideTile(mTile);
+            lFloorGrate->emplaceTile(mTile.body->getPosition(), mGrateRect);
+            return true;
+        }
+
+        inline OBCTileLayer& getFloor() noexcept { return *lFloor; }
+        inline OBCTileLayer& getFloorGrate() noexcept { return *lFloorGrate; }
+        inline OBCTileLayer& getPit() noexcept { return *lPit; }
+        inline OBCTileLayer& getWall() noexcept { return *lWall; }
+    };
+}
+
+#endif
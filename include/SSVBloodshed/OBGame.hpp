@@ -8,9 +8,21 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBAssets.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
+#include "SSVBloodshed/OBLevelArena.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
 #include "SSVBloodshed/OBFactory.hpp"
 #include "SSVBloodshed/OBGDebugText.hpp"
 #include "SSVBloodshed/OBGParticles.hpp"
+#include "SSVBloodshed/OBGTiles.hpp"
+#include "SSVBloodshed/OBGCommands.hpp"
+#include "SSVBloodshed/OBGFlowField.hpp"
+#include "SSVBloodshed/OBGSightGrid.hpp"
+#include "SSVBloodshed/OBGAIScheduler.hpp"
+#include "SSVBloodshed/OBGTargetRegistry.hpp"
+#include "SSVBloodshed/OBGBoidGrid.hpp"
+#include "SSVBloodshed/OBGShards.hpp"
+#include "SSVBloodshed/OBGProjectiles.hpp"
+#include "SSVBloodshed/OBGIdLinks.hpp"
 #include "SSVBloodshed/OBGInput.hpp"
 #include "SSVBloodshed/OBBarCounter.hpp"
 #include "SSVBloodshed/OBSharedData.hpp"
@@ -116,16 +128,29 @@ namespace ob
             overlayCamera{gameWindow, 2.f};
         OBFactory factory{assets, *this, manager};
         World world{1000, 1000, 1000, 500};
+        OBGBoidGrid boidGrid; // Boids unregister themselves, must outlive them
+        OBGShards shards;     // Shards too
+        OBGProjectiles projectiles; // Projectiles too
+        OBGIdLinks idLinks;   // Id receivers and trails too
+        OBGAIScheduler aiScheduler; // Enemies too
+        OBWorkers workers{OBConfig::getAIThreads()};
         sses::Manager manager;
 
         OBGInput<OBGame> input{*this};
         OBGParticles particles;
+        OBGTiles tiles;
+        OBGCommands commands;
+        OBGFlowField flowField;
+        OBGSightGrid sightGrid;
+        OBGTargetRegistry targetRegistry;
         OBGDebugText<OBGame> debugText{*this};
         OBGameHUD hud{assets, overlayCamera};
 
         OBLEEditor* editor{nullptr};
         OBSharedData sharedData;
-        std::unordered_map<OBLELevel*, OBGLevelStat> levelStats;
+        // Keyed by sector and level position - levels may be evicted from
+        // the pack and read again at another address
+        std::map<std::tuple<int, int, int>, OBGLevelStat> levelStats;
 
         bool paused{true};
         sf::RectangleShape pauseRect{
@@ -162,11 +187,11 @@ namespace ob
         }
 
     public:
-        ssvu::Delegate<void()> onPostUpdate;
-
         inline OBGame(ssvs::GameWindow& mGameWindow, OBAssets& mAssets)
             : gameWindow(mGameWindow), assets(mAssets)
         {
+            sharedData.setLevelCacheSize(OBConfig::getLevelCacheKB() * 1024);
+
             gameState.onUpdate += [this](FT mFT)
             {
                 update(mFT);
@@ -239,13 +264,40 @@ namespace ob
             };
             manager.clear();
             world.clear();
+
+            // Components that outlive the clear keep their blocks, and the
+            // arena is only released on a later load
+            auto& arena(OBLevelArena::get());
+            if(!arena.reset())
+                ssvu::lo("OBLevelArena") << arena.getLiveCount()
+                                         << " components outlived their level"
+                                         << std::endl;
+
             particles.clear(factory);
+            tiles.clear(factory);
+            flowField.clear();
+            sightGrid.clear();
+            targetRegistry.clear();
+            idLinks.clear();
+            commands.clear();
 
             try
             {
-                for(auto& p : sharedData.getCurrentTiles())
-                    sharedData.getDatabase().spawn(sharedData.getCurrentLevel(),
-                        p.second, getTilePos(p.second.getX(), p.second.getY()));
+                // Levels missing from the baked pack are baked on the spot
+                OBLEBakedLevel fresh;
+                auto baked(sharedData.getCurrentBakedLevel());
+                if(baked == nullptr)
+                {
+                    fresh = bakeLevel(sharedData.getCurrentLevel());
+                    baked = &fresh;
+                }
+
+                for(const auto& p : baked->idLinks)
+                    idLinks.reserve(p.first, p.second.receivers.size());
+                idLinks.setPlateClusterCount(baked->plateClusters.size());
+
+                for(const auto& s : baked->spawns)
+                    sharedData.getDatabase().spawn(s, getTilePos(s.x, s.y));
             }
             catch(...)
             {
@@ -275,34 +327,38 @@ namespace ob
 
             if(!sharedData.isLevelValid(nextLevelX, nextLevelY)) return false;
 
-            onPostUpdate += [this, nextLevelX, nextLevelY, playerData]
-            {
-                if(sharedData.getCurrentLevelX() != nextLevelX ||
-                    sharedData.getCurrentLevelY() != nextLevelY)
-                {
-                    sharedData.setCurrentLevel(nextLevelX, nextLevelY);
-                    loadCurrentLevel();
-
-                    // Remove existing players (TODO: change)
-                    for(auto& e : manager.getEntities(OBGroup::GPlayer))
-                        e->destroy();
-
-                    // If the level was cleared, remove all enemies (TODO:
-                    // change
-                    // not spawn)
-                    if(levelStats[&sharedData.getCurrentLevel()].clear)
-                        for(auto& e : manager.getEntities(OBGroup::GEnemy))
-                            e->destroy();
-
-                    factory.createPlayer(playerData.pos)
-                        .template getComponent<TPlayer>()
-                        .initFromData(playerData);
-                }
-            };
+            commands.changeLevel(nextLevelX, nextLevelY, playerData);
+            return true;
+        }
+
+        // Loads the level at `mX`, `mY` if it isn't the current one already
+        // - called when applying a recorded level change
+        inline bool enterLevel(int mX, int mY)
+        {
+            if(sharedData.getCurrentLevelX() == mX &&
+                sharedData.getCurrentLevelY() == mY)
+                return false;
+
+            sharedData.setCurrentLevel(mX, mY);
+            loadCurrentLevel();
+
+            // Remove existing players (TODO: change)
+            for(auto& e : manager.getEntities(OBGroup::GPlayer)) e->destroy();
+
+            // If the level was cleared, remove all enemies (TODO: change
+            // not spawn)
+            if(getCurrentLevelStat().clear)
+                for(auto& e : manager.getEntities(OBGroup::GEnemy))
+                    e->destroy();
 
             return true;
         }
 
+        inline OBGLevelStat& getCurrentLevelStat()
+        {
+            return levelStats[std::make_tuple(sharedData.getCurrentSectorIdx(),
+                sharedData.getCurrentLevelX(), sharedData.getCurrentLevelY())];
+        }
         inline bool isLevelClear() noexcept
         {
             return manager.getEntityCount(OBGroup::GEnemy) <= 0;
@@ -310,13 +366,22 @@ namespace ob
         inline void updateLevelStat() noexcept
         {
             if(isLevelClear())
-                levelStats[&sharedData.getCurrentLevel()].clear = true;
+                getCurrentLevelStat().clear = true;
         }
 
         inline void update(FT mFT)
         {
             if(!paused && !sharedData.isCurrentLevelNull())
             {
+                flowField.refresh();
+                targetRegistry.refresh(manager);
+                boidGrid.refresh();
+                boidGrid.decide(workers);
+                aiScheduler.refresh(mFT);
+                aiScheduler.decide(
+                    {targetRegistry, sightGrid, flowField}, workers);
+                shards.refresh();
+                projectiles.update(mFT);
                 manager.update(mFT);
                 world.update(mFT);
             }
@@ -331,8 +396,7 @@ namespace ob
             if(!paused && !sharedData.isCurrentLevelNull())
             {
                 updateLevelStat();
-                onPostUpdate();
-                onPostUpdate.clear();
+                commands.apply(*this);
             }
 
             hud.update(mFT);
@@ -385,6 +449,25 @@ namespace ob
         inline ssvs::GameState& getGameState() noexcept { return gameState; }
         inline World& getWorld() noexcept { return world; }
         inline sses::Manager& getManager() noexcept { return manager; }
+        inline OBGTiles& getTiles() noexcept { return tiles; }
+        inline OBGCommands& getCommands() noexcept { return commands; }
+        inline OBGFlowField& getFlowField() noexcept { return flowField; }
+        inline OBGSightGrid& getSightGrid() noexcept { return sightGrid; }
+        inline OBGAIScheduler& getAIScheduler() noexcept
+        {
+            return aiScheduler;
+        }
+        inline const OBGTargetRegistry& getTargetRegistry() const noexcept
+        {
+            return targetRegistry;
+        }
+        inline OBGBoidGrid& getBoidGrid() noexcept { return boidGrid; }
+        inline OBGShards& getShards() noexcept { return shards; }
+        inline OBGProjectiles& getProjectiles() noexcept
+        {
+            return projectiles;
+        }
+        inline OBGIdLinks& getIdLinks() noexcept { return idLinks; }
         inline const decltype(input)& getInput() const noexcept
         {
             return input;
@@ -395,6 +478,15 @@ namespace ob
             return overlayCamera;
         }
 
+        inline void smashFloor(OBTile& mTile)
+        {
+            if(!tiles.smashFloor(mTile, assets.getFloorGrateVariant())) return;
+
+            const auto& pos(toPixels(mTile.body->getPosition()));
+            createPDebris(20, pos);
+            createPDebrisFloor(4, pos);
+        }
+
         inline void createPBlood(
             SizeT mCount, const Vec2f& mPos, float mMult = 1.f)
         {
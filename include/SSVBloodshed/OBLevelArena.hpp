@@ -0,0 +1,149 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_LEVELARENA
+#define SSVOB_LEVELARENA
+
+#include <cstddef>
+#include <thread>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Monotonic memory for the game's components, which live as long as
+    // the current level - entities and bodies are owned by sses and ssvsc,
+    // which have no allocator hooks, and stay on the global heap
+    // Freed blocks go to per-size-class free lists and get reused, and the
+    // whole arena is released at once when the level is left - chunks are
+    // kept around for the next level
+    //
+    // Not synchronized: components are only created and destroyed on the
+    // main thread, workers only read them
+    class OBLevelArena
+    {
+    private:
+        static constexpr SizeT chunkSize{256 * 1024};
+        static constexpr SizeT granularity{alignof(std::max_align_t)};
+        static constexpr SizeT classCount{64};
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        std::vector<std::unique_ptr<char[]>> chunks;
+        std::vector<std::unique_ptr<char[]>> bigChunks;
+        std::array<FreeBlock*, classCount> freeLists;
+        SizeT chunkIdx{0}, offset{0}, liveCount{0};
+        std::thread::id owner{std::this_thread::get_id()};
+
+        inline OBLevelArena() { freeLists.fill(nullptr); }
+
+        inline void checkThread() const noexcept
+        {
+            SSVU_ASSERT(std::this_thread::get_id() == owner);
+        }
+
+        static constexpr SizeT getRounded(SizeT mSize) noexcept
+        {
+            return (mSize + granularity - 1) / granularity * granularity;
+        }
+        static constexpr SizeT getClassIdx(SizeT mSize) noexcept
+        {
+            return getRounded(mSize) / granularity - 1;
+        }
+
+        inline void* allocateFromChunks(SizeT mSize)
+        {
+            if(mSize > chunkSize)
+            {
+                bigChunks.emplace_back(new char[mSize]);
+                return bigChunks.back().get();
+            }
+
+            if(chunks.empty() || offset + mSize > chunkSize)
+            {
+                if(!chunks.empty()) ++chunkIdx;
+                if(chunkIdx == chunks.size())
+                    chunks.emplace_back(new char[chunkSize]);
+                offset = 0;
+            }
+
+            auto result(chunks[chunkIdx].get() + offset);
+            offset += mSize;
+            return result;
+        }
+
+    public:
+        inline static OBLevelArena& get() noexcept
+        {
+            static OBLevelArena instance;
+            return instance;
+        }
+
+        inline void* allocate(SizeT mSize)
+        {
+            checkThread();
+            ++liveCount;
+            auto size(getRounded(mSize));
+            auto idx(getClassIdx(size));
+
+            if(idx < classCount && freeLists[idx] != nullptr)
+            {
+                auto result(freeLists[idx]);
+                freeLists[idx] = result->next;
+                return result;
+            }
+
+            return allocateFromChunks(size);
+        }
+        inline void deallocate(void* mPtr, SizeT mSize) noexcept
+        {
+            checkThread();
+            SSVU_ASSERT(liveCount > 0);
+            --liveCount;
+
+            // Blocks bigger than the largest class stay until the next reset
+            auto idx(getClassIdx(mSize));
+            if(idx >= classCount) return;
+
+            auto block(static_cast<FreeBlock*>(mPtr));
+            block->next = freeLists[idx];
+            freeLists[idx] = block;
+        }
+
+        // Releases everything allocated since the last reset, if no level
+        // object is alive anymore - otherwise nothing is released, and the
+        // blocks of the objects that are still alive are reused through the
+        // free lists when they die
+        inline bool reset() noexcept
+        {
+            checkThread();
+            if(liveCount != 0) return false;
+
+            freeLists.fill(nullptr);
+            bigChunks.clear();
+            chunkIdx = offset = 0;
+            return true;
+        }
+
+        inline SizeT getLiveCount() const noexcept { return liveCount; }
+    };
+
+    // Types deriving from this are allocated from the level arena
+    struct OBLevelAllocated
+    {
+        inline void* operator new(std::size_t mSize)
+        {
+            return OBLevelArena::get().allocate(mSize);
+        }
+        inline void operator delete(
+            void* mPtr, std::size_t mSize) noexcept
+        {
+            OBLevelArena::get().deallocate(mPtr, mSize);
+        }
+    };
+}
+
+#endif
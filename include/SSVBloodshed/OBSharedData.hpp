@@ -9,6 +9,8 @@
 #include "SSVBloodshed/OBAssets.hpp"
 #include "SSVBloodshed/OBConfig.hpp"
 #include "SSVBloodshed/LevelEditor/OBLEJson.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBinary.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBake.hpp"
 #include "SSVBloodshed/LevelEditor/OBLEDatabase.hpp"
 #include "SSVBloodshed/LevelEditor/OBLEPack.hpp"
 #include "SSVBloodshed/LevelEditor/OBLESector.hpp"
@@ -21,10 +23,12 @@ namespace ob
     private:
         OBLEDatabase* database{nullptr};
         OBLEPack pack;
+        OBLEBakedPack baked;
         OBLESector* currentSector{nullptr};
         OBLELevel* currentLevel{nullptr};
         ssvufs::Path currentPath;
         int currentSectorIdx{0}, currentLevelX{0}, currentLevelY{0};
+        SizeT levelCacheSize{0};
 
         inline void setPath(const ssvufs::Path& mPath)
         {
@@ -37,6 +41,8 @@ namespace ob
         {
             SSVU_ASSERT(database != nullptr);
             pack = OBLEPack{};
+            pack.setMemoryCap(levelCacheSize);
+            baked = OBLEBakedPack{};
             currentSector = nullptr;
             currentLevel = nullptr;
         }
@@ -48,7 +54,14 @@ namespace ob
 
             try
             {
-                pack = ssvj::fromFile(currentPath).as<OBLEPack>();
+                pack = OBLEBinary::loadPack(currentPath.getStr());
+                pack.setMemoryCap(levelCacheSize);
+                loadBakedPack();
+            }
+            catch(const std::exception& mError)
+            {
+                ssvu::lo("Fatal error") << "Failed to load pack: "
+                                        << mError.what() << std::endl;
             }
             catch(...)
             {
@@ -58,10 +71,16 @@ namespace ob
         inline void savePack(const ssvufs::Path& mPath)
         {
             setPath(mPath);
+            baked = OBLEBakedPack{};
 
             try
             {
-                ssvj::Val{pack}.writeToFile<ssvj::WSMinified>(currentPath);
+                OBLEBinary::savePack(pack, currentPath.getStr());
+            }
+            catch(const std::exception& mError)
+            {
+                ssvu::lo("Fatal error") << "Failed to save pack: "
+                                        << mError.what() << std::endl;
             }
             catch(...)
             {
@@ -69,6 +88,26 @@ namespace ob
             }
         }
 
+        // Baked packs are written next to their pack by the baker - levels
+        // changed since baking are baked again when entered
+        inline void loadBakedPack()
+        {
+            baked = OBLEBakedPack{};
+
+            auto path(currentPath.getStr() + ".baked");
+            if(!ssvufs::Path{path}.exists<ssvufs::Type::File>()) return;
+
+            try
+            {
+                baked = OBLEBakedPack::readFromFile(path);
+            }
+            catch(const std::exception& mError)
+            {
+                ssvu::lo("Warning") << "Failed to load baked pack: "
+                                    << mError.what() << std::endl;
+            }
+        }
+
         inline void setDatabase(
             OBLEDatabase& mDatabase, OBGame* mGame = nullptr) noexcept
         {
@@ -93,10 +132,34 @@ namespace ob
 
             currentLevelX = mX;
             currentLevelY = mY;
-            currentLevel = &getCurrentSector().getLevel(mX, mY);
+            currentLevel = &pack.getLevel(currentSectorIdx, mX, mY);
+        }
+        inline void clearCurrentSector()
+        {
+            pack.clearSector(currentSectorIdx);
+            currentLevel = nullptr;
+        }
+
+        // Bytes of levels kept resident before the least recently used ones
+        // are evicted - 0 never evicts
+        inline void setLevelCacheSize(SizeT mBytes)
+        {
+            levelCacheSize = mBytes;
+            pack.setMemoryCap(levelCacheSize);
         }
 
         inline OBLEDatabase& getDatabase() noexcept { return *database; }
+        // Null if the current level wasn't baked, or was edited since -
+        // hashing the level is much cheaper than baking it
+        inline const OBLEBakedLevel* getCurrentBakedLevel() const
+        {
+            auto result(baked.find(getCurrentSectorIdx(),
+                getCurrentSector().getKey(currentLevelX, currentLevelY)));
+            if(result == nullptr ||
+                result->sourceHash != getLevelHash(getCurrentLevel()))
+                return nullptr;
+            return result;
+        }
         inline OBLEPack& getPack() noexcept { return pack; }
         inline OBLESector& getCurrentSector() const noexcept
         {
@@ -108,10 +171,6 @@ namespace ob
             SSVU_ASSERT(currentLevel != nullptr);
             return *currentLevel;
         }
-        inline decltype(currentLevel->getTiles()) getCurrentTiles() const
-        {
-            return getCurrentLevel().getTiles();
-        }
         inline const ssvufs::Path& getCurrentPath() const noexcept
         {
             return currentPath;
@@ -0,0 +1,62 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_STEERING
+#define SSVOB_STEERING
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Desired velocities of the steering behaviors, for an agent at `mPos`
+    // moving at most at `mMaxVel` - they only depend on their arguments, so
+    // they can be evaluated on snapshots
+    namespace OBSteering
+    {
+        inline Vec2f getSeekVel(const Vec2f& mPos, Vec2f mTarget,
+            float mMaxVel, float mSlowRadius) noexcept
+        {
+            SSVU_ASSERT(mSlowRadius != 0);
+
+            mTarget -= mPos;
+            float distance{ssvs::getMag(mTarget)};
+            ssvs::resize(mTarget, distance <= mSlowRadius
+                                      ? mMaxVel * distance / mSlowRadius
+                                      : mMaxVel);
+            return mTarget;
+        }
+        inline Vec2f getFleeVel(
+            const Vec2f& mPos, Vec2f mTarget, float mMaxVel) noexcept
+        {
+            mTarget = mPos - mTarget;
+            ssvs::resize(mTarget, mMaxVel);
+            return mTarget;
+        }
+
+        inline Vec2f getPursuitVel(const Vec2f& mPos, const Vec2f& mTargetPos,
+            const Vec2f& mTargetVel, float mMaxVel, float mPredictionMult,
+            float mSlowRadius) noexcept
+        {
+            SSVU_ASSERT(mMaxVel != 0);
+
+            Vec2f distance{mTargetPos - mPos};
+            float prediction{ssvs::getMag(distance) / mMaxVel};
+            return getSeekVel(mPos,
+                mTargetPos + mTargetVel * (prediction * mPredictionMult),
+                mMaxVel, mSlowRadius);
+        }
+        inline Vec2f getEvadeVel(const Vec2f& mPos, const Vec2f& mTargetPos,
+            const Vec2f& mTargetVel, float mMaxVel) noexcept
+        {
+            SSVU_ASSERT(mMaxVel != 0);
+
+            Vec2f distance{mTargetPos - mPos};
+            float prediction{ssvs::getMag(distance) / mMaxVel};
+            return getFleeVel(
+                mPos, mTargetPos + mTargetVel * prediction, mMaxVel);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_WORKERS
+#define SSVOB_WORKERS
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Fixed pool of threads running data-parallel loops - the calling thread
+    // works too, so a pool of one thread runs everything inline
+    //
+    // An exception thrown by any range is rethrown by `forRanges`, once
+    // every thread is done with the loop
+    class OBWorkers
+    {
+    private:
+        using Job = std::function<void(SizeT, SizeT)>;
+
+        std::vector<std::thread> threads;
+        std::mutex mtx;
+        std::condition_variable cvStart, cvDone;
+        Job job;
+        std::exception_ptr error;
+        SizeT jobSize{0}, generation{0}, pending{0};
+        bool stopping{false};
+
+        // Static partitioning: thread `mIdx` always gets the same range
+        inline void runChunk(SizeT mIdx) noexcept
+        {
+            auto count(threads.size() + 1);
+            auto begin(jobSize * mIdx / count),
+                end(jobSize * (mIdx + 1) / count);
+            if(begin == end) return;
+
+            try
+            {
+                job(begin, end);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                if(!error) error = std::current_exception();
+            }
+        }
+
+        inline void workerLoop(SizeT mIdx)
+        {
+            SizeT lastGeneration{0};
+
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mtx};
+                    cvStart.wait(lock, [this, &lastGeneration]
+                        {
+                            return stopping || generation != lastGeneration;
+                        });
+                    if(stopping) return;
+                    lastGeneration = generation;
+                }
+
+                runChunk(mIdx);
+
+                std::lock_guard<std::mutex> lock{mtx};
+                if(--pending == 0) cvDone.notify_one();
+            }
+        }
+
+    public:
+        inline OBWorkers(SizeT mCount)
+        {
+            for(auto i(1u); i < mCount; ++i)
+                threads.emplace_back([this, i]
+                    {
+                        workerLoop(i);
+                    });
+        }
+        inline ~OBWorkers()
+        {
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                stopping = true;
+            }
+            cvStart.notify_all();
+            for(auto& t : threads) t.join();
+        }
+
+        // Calls `mF(begin, end)` over disjoint ranges covering [0, mSize)
+        // and returns once all of them are done - `mF` and what it captures
+        // are never used after that, even if a range threw
+        template <typename TF>
+        inline void forRanges(SizeT mSize, const TF& mF)
+        {
+            if(threads.empty())
+            {
+                if(mSize > 0) mF(0, mSize);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                job = mF;
+                jobSize = mSize;
+                pending = threads.size();
+                ++generation;
+            }
+            cvStart.notify_all();
+
+            runChunk(0);
+
+            std::unique_lock<std::mutex> lock{mtx};
+            cvDone.wait(lock, [this]
+                {
+                    return pending == 0;
+                });
+
+            if(!error) return;
+            auto e(error);
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+
+        inline SizeT getCount() const noexcept { return threads.size() + 1; }
+    };
+}
+
+#endif
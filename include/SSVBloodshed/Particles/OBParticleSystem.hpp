@@ -69,10 +69,14 @@ namespace ob
             mRenderTarget.draw(&vertices[0], currentCount * 4,
                 sf::PrimitiveType::Quads, mRenderStates);
         }
-        inline void clear() noexcept
+        inline void clear()
         {
             particles.clear();
             currentCount = 0;
+
+            // Picks up changes of the maximum particle count (no-op otherwise)
+            vertices.resize(OBConfig::getParticleMax() * 4);
+            particles.reserve(OBConfig::getParticleMax());
         }
     };
 }
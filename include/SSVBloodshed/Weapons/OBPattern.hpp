@@ -0,0 +1,157 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_WEAPONS_PATTERN
+#define SSVOB_WEAPONS_PATTERN
+
+#include "SSVBloodshed/OBCommon.hpp"
+
+namespace ob
+{
+    // Shape of a single volley - every emitted direction either becomes a
+    // bullet or, if the pattern has children, the origin of its children
+    struct OBPattern
+    {
+        enum class Type : int
+        {
+            Single, // `count` bullets along the aim direction
+            Fan,    // `count` bullets `step` degrees apart, centered on aim
+            Ring,   // `count` bullets evenly spread around the aim
+            Spiral, // `count` bullets `step` degrees apart, starting at aim
+            Burst   // `count` bullets aimed within +-`step` degrees
+        };
+
+        Type type{Type::Single};
+        int count{1};
+        float step{0.f};
+
+        // Speed lost by every bullet per step away from the first (or, for
+        // fans, from the central) one
+        float speedChange{0.f};
+
+        // Distance from the origin along the bullet's direction
+        float dist{0.f};
+
+        std::vector<OBPattern> children;
+
+        inline OBPattern() = default;
+        inline OBPattern(Type mType, int mCount, float mStep = 0.f,
+            float mSpeedChange = 0.f, float mDist = 0.f)
+            : type{mType}, count{mCount}, step{mStep},
+              speedChange{mSpeedChange}, dist{mDist}
+        {
+        }
+    };
+
+    struct OBPatternShot
+    {
+        Vec2i pos;
+        float deg, speedOffset;
+    };
+
+    namespace Impl
+    {
+        inline void evaluatePattern(const OBPattern& mPattern,
+            const Vec2f& mOrigin, float mDeg, float mSpeedOffset,
+            std::vector<OBPatternShot>& mOut)
+        {
+            using Type = OBPattern::Type;
+            const auto& p(mPattern);
+
+            for(int i{0}; i < p.count; ++i)
+            {
+                auto deg(mDeg);
+                auto steps(static_cast<float>(i));
+
+                switch(p.type)
+                {
+                    case Type::Single: break;
+                    case Type::Fan:
+                        steps = i - (p.count - 1) / 2.f;
+                        deg += steps * p.step;
+                        steps = std::abs(steps);
+                        break;
+                    case Type::Ring: deg += 360.f / p.count * i; break;
+                    case Type::Spiral: deg += i * p.step; break;
+                    case Type::Burst:
+                        if(p.step != 0.f)
+                            deg += ssvu::getRndR(-p.step, p.step);
+                        break;
+                }
+
+                Vec2f pos{mOrigin + ssvs::getVecFromDeg<float>(deg) * p.dist};
+                auto speedOffset(mSpeedOffset - steps * p.speedChange);
+
+                if(p.children.empty())
+                {
+                    mOut.push_back({Vec2i(pos), deg, speedOffset});
+                    continue;
+                }
+
+                for(const auto& c : p.children)
+                    evaluatePattern(c, pos, deg, speedOffset, mOut);
+            }
+        }
+
+        inline SizeT getPatternShotCount(const OBPattern& mPattern) noexcept
+        {
+            if(mPattern.children.empty()) return mPattern.count;
+
+            SizeT result{0};
+            for(const auto& c : mPattern.children)
+                result += getPatternShotCount(c);
+            return result * mPattern.count;
+        }
+    }
+
+    // Appends every bullet of a volley aimed at `mDeg` to `mOut`, growing it
+    // at most once
+    inline void evaluatePattern(const OBPattern& mPattern, const Vec2i& mPos,
+        float mDeg, std::vector<OBPatternShot>& mOut)
+    {
+        mOut.reserve(mOut.size() + Impl::getPatternShotCount(mPattern));
+        Impl::evaluatePattern(mPattern, Vec2f(mPos), mDeg, 0.f, mOut);
+    }
+
+    // Patterns are described as
+    //     [type, count, step, speedChange, dist, [child, ...]]
+    // where type is one of "single", "fan", "ring", "spiral", "burst" and
+    // every element after the type is optional
+    inline OBPattern getPatternFromJson(const ssvj::Val& mVal)
+    {
+        static std::map<std::string, OBPattern::Type> types{
+            {"single", OBPattern::Type::Single},
+            {"fan", OBPattern::Type::Fan}, {"ring", OBPattern::Type::Ring},
+            {"spiral", OBPattern::Type::Spiral},
+            {"burst", OBPattern::Type::Burst}};
+
+        const auto& a(mVal.as<ssvj::Arr>());
+        auto getArg([&a](SizeT mIdx)
+            {
+                return mIdx < a.size() ? a[mIdx].as<float>() : 0.f;
+            });
+
+        OBPattern result;
+
+        auto itr(types.find(a[0].as<std::string>()));
+        if(itr != std::end(types))
+            result.type = itr->second;
+        else
+            ssvu::lo("OBPattern") << "Unknown pattern type: "
+                                  << a[0].as<std::string>() << std::endl;
+
+        if(a.size() > 1) result.count = a[1].as<int>();
+        result.step = getArg(2);
+        result.speedChange = getArg(3);
+        result.dist = getArg(4);
+
+        if(a.size() > 5)
+            for(const auto& c : a[5].as<ssvj::Arr>())
+                result.children.emplace_back(getPatternFromJson(c));
+
+        return result;
+    }
+}
+
+#endif
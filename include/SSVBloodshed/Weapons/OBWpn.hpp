@@ -9,14 +9,16 @@
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Components/OBCProjectile.hpp"
 #include "SSVBloodshed/Weapons/OBWpnType.hpp"
+#include "SSVBloodshed/Weapons/OBWpnTypes.hpp"
 
 namespace ob
 {
+    // Per-wielder handle to an interned weapon type
     class OBWpn
     {
     private:
         OBGame& game;
-        OBWpnType wpnType;
+        OBWpnTypeId wpnTypeId{WMachineGun};
         OBGroup targetGroup;
 
     public:
@@ -26,40 +28,37 @@ namespace ob
         {
         }
         inline OBWpn(OBGame& mGame, OBGroup mTargetGroup,
-            const OBWpnType& mWpn) noexcept : game(mGame),
-                                              targetGroup{mTargetGroup}
+            OBWpnTypeId mWpnTypeId) noexcept : game(mGame),
+                                               wpnTypeId{mWpnTypeId},
+                                               targetGroup{mTargetGroup}
         {
-            setWpn(mWpn);
         }
 
         inline void shoot(OBCActorND* mShooter, const Vec2i& mPos, float mDeg,
             const Vec2f& mMuzzlePxPos)
         {
-            wpnType.shoot(game, mShooter, mPos, mDeg, mMuzzlePxPos);
+            getWpnType().shoot(
+                game, mShooter, targetGroup, mPos, mDeg, mMuzzlePxPos);
         }
-        inline void playSound() { wpnType.playSound(game); }
+        inline void playSound() { getWpnType().playSound(game); }
 
-        inline void setWpn(const OBWpnType& mWpnType) noexcept
+        inline void setWpn(OBWpnTypeId mWpnTypeId) noexcept
         {
-            wpnType = mWpnType;
-            wpnType.onShotProjectile += [this](OBCProjectile& mPj)
-            {
-                mPj.setTargetGroup(targetGroup);
-            };
+            wpnTypeId = mWpnTypeId;
         }
 
         inline OBGame& getGame() noexcept { return game; }
-        inline const OBWpnType& getWpnType() const noexcept { return wpnType; }
-        inline OBWpnType& getWpnType() noexcept { return wpnType; }
-        inline float getDelay() const noexcept { return wpnType.getDelay(); }
-        inline float getPjDamage() const noexcept
+        inline OBWpnTypeId getWpnTypeId() const noexcept { return wpnTypeId; }
+        inline const OBWpnType& getWpnType() const
         {
-            return wpnType.getPjDamage();
+            return OBWpnTypes::getRegistry()[wpnTypeId];
         }
-        inline float getPjSpeed() const noexcept
+        inline float getDelay() const { return getWpnType().getDelay(); }
+        inline float getPjDamage() const
         {
-            return wpnType.getPjSpeed();
+            return getWpnType().getPjDamage();
         }
+        inline float getPjSpeed() const { return getWpnType().getPjSpeed(); }
     };
 }
 
@@ -0,0 +1,74 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVOB_WEAPONS_WPNREGISTRY
+#define SSVOB_WEAPONS_WPNREGISTRY
+
+#include <deque>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/Weapons/OBWpnType.hpp"
+
+namespace ob
+{
+    // Weapon types registered at startup, in registration order
+    enum OBWpnBuiltin : OBWpnTypeId
+    {
+        WMachineGun,
+        WPlasmaBolter,
+        WPlasmaCannon,
+        WRocketLauncher,
+        WGrenadeLauncher,
+        WShockwaveGun,
+        WEPlasmaBulletGun,
+        WEPlasmaBulletGunFan1,
+        WEPlasmaBulletGunFan2,
+        WEPlasmaBulletGunTurret,
+        WEPlasmaStarGun,
+        WBuiltinCount
+    };
+
+    // Interned weapon types - every wielder refers to a type by its id, so
+    // switching or spawning weapons never copies one
+    class OBWpnRegistry
+    {
+    public:
+        static constexpr OBWpnTypeId nullId{
+            std::numeric_limits<OBWpnTypeId>::max()};
+
+    private:
+        // Deque elements never move, keeping returned references valid
+        std::deque<OBWpnType> types;
+        std::map<std::string, OBWpnTypeId> ids;
+
+    public:
+        inline OBWpnTypeId add(OBWpnType mWpnType)
+        {
+            SSVU_ASSERT(types.size() < nullId);
+            types.emplace_back(ssvu::mv(mWpnType));
+            return types.size() - 1;
+        }
+        inline OBWpnTypeId add(const std::string& mName, OBWpnType mWpnType)
+        {
+            auto result(add(ssvu::mv(mWpnType)));
+            ids[mName] = result;
+            return result;
+        }
+
+        // Returns `nullId` if no type was registered under `mName`
+        inline OBWpnTypeId getId(const std::string& mName) const
+        {
+            auto itr(ids.find(mName));
+            return itr == std::end(ids) ? nullId : itr->second;
+        }
+
+        inline const OBWpnType& operator[](OBWpnTypeId mId) const noexcept
+        {
+            SSVU_ASSERT(mId < types.size());
+            return types[mId];
+        }
+        inline SizeT getCount() const noexcept { return types.size(); }
+    };
+}
+
+#endif
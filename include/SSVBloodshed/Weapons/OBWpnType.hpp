@@ -7,55 +7,56 @@
 
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/Components/OBCProjectile.hpp"
+#include "SSVBloodshed/Weapons/OBPattern.hpp"
 
 namespace ob
 {
     class OBGame;
 
+    // Immutable once registered - weapons are shared through
+    // `OBWpnRegistry` and referenced by id, never copied per wielder
     class OBWpnType
     {
+    public:
+        using ShootFn = void (*)(const OBWpnType&, OBGame&, OBCActorND*,
+            OBGroup, const Vec2i&, float, const Vec2f&);
+
     protected:
         float delay{1000.f}, pjDamage{0.f}, pjSpeed{0.f};
         std::string soundId{""};
+        OBPattern pattern;
+        ShootFn onShoot{nullptr};
 
     public:
-        ssvu::Delegate<void(OBWpnType&, OBGame&, OBCActorND*, const Vec2i&,
-            float, const Vec2f&)> onShoot;
-        ssvu::Delegate<void(OBCProjectile&)> onShotProjectile;
-
         inline OBWpnType() = default;
         inline OBWpnType(float mDelay, float mDamage, float mPjSpeed,
-            std::string mSoundId) noexcept : delay{mDelay},
-                                             pjDamage{mDamage},
-                                             pjSpeed{mPjSpeed},
-                                             soundId{ssvu::mv(mSoundId)}
-        {
-        }
-        template <typename T>
-        inline OBWpnType(float mDelay, float mDamage, float mPjSpeed,
-            std::string mSoundId, T mOnShoot) noexcept
+            std::string mSoundId, ShootFn mOnShoot = nullptr) noexcept
             : delay{mDelay},
               pjDamage{mDamage},
               pjSpeed{mPjSpeed},
-              soundId{ssvu::mv(mSoundId)}
+              soundId{ssvu::mv(mSoundId)},
+              onShoot{mOnShoot}
         {
-            onShoot += mOnShoot;
         }
 
         inline void shoot(OBGame& mGame, OBCActorND* mShooter,
-            const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePosPx)
+            OBGroup mTargetGroup, const Vec2i& mPos, float mDeg,
+            const Vec2f& mMuzzlePosPx) const
         {
-            onShoot(*this, mGame, mShooter, mPos, mDeg, mMuzzlePosPx);
+            if(onShoot != nullptr)
+                onShoot(*this, mGame, mShooter, mTargetGroup, mPos, mDeg,
+                    mMuzzlePosPx);
         }
-        inline OBCProjectile& shotProjectile(Entity& mEntity)
+        inline OBCProjectile& shotProjectile(
+            Entity& mEntity, OBGroup mTargetGroup) const
         {
             auto& pj(mEntity.getComponent<OBCProjectile>());
             pj.setDamage(pjDamage);
             pj.setSpeed(pjSpeed);
-            onShotProjectile(pj);
+            pj.setTargetGroup(mTargetGroup);
             return pj;
         }
-        inline void playSound(OBGame& mGame)
+        inline void playSound(OBGame& mGame) const
         {
             mGame.getAssets().playSound(soundId);
         }
@@ -63,10 +64,12 @@ namespace ob
         inline void setDelay(float mValue) noexcept { delay = mValue; }
         inline void setPjDamage(float mValue) noexcept { pjDamage = mValue; }
         inline void setPjSpeed(float mValue) noexcept { pjSpeed = mValue; }
+        inline void setPattern(OBPattern mValue) { pattern = ssvu::mv(mValue); }
 
         inline float getDelay() const noexcept { return delay; }
         inline float getPjDamage() const noexcept { return pjDamage; }
         inline float getPjSpeed() const noexcept { return pjSpeed; }
+        inline const OBPattern& getPattern() const noexcept { return pattern; }
         inline const std::string& getSoundId() const noexcept
         {
             return soundId;
@@ -8,29 +8,36 @@
 #include "SSVBloodshed/OBCommon.hpp"
 #include "SSVBloodshed/OBGame.hpp"
 #include "SSVBloodshed/Weapons/OBWpnType.hpp"
+#include "SSVBloodshed/Weapons/OBWpnRegistry.hpp"
 #include "SSVBloodshed/Components/OBCProjectile.hpp"
 
 namespace ob
 {
     namespace OBWpnTypes
     {
-        // using FactoryMemPtr = Entity&(OBFactory::*)(const Vec2i& mPos, float
-        // mDeg);
-        // template<typename... TArgs> using FactoryMemPtr =
-        // Entity&(OBFactory::*)(TArgs...);
-
-        template <typename T>
-        inline void fanShoot(T mFactoryAction, OBWpnType& mWpn, OBGame& mGame,
-            OBCActorND* mShooter, const Vec2i& mPos, float mDeg, int mCount,
-            float mStep, float mSpeedChange)
+        // Evaluates the weapon's pattern into a reused buffer, then spawns
+        // the whole volley in a single pass - the projectile store grows
+        // at most once per volley, but every bullet is still an entity with
+        // its own body, as collisions go through the world
+        template <typename T, typename... TArgs>
+        inline void patternShoot(T mFactoryAction, const OBWpnType& mWpn,
+            OBGame& mGame, OBCActorND* mShooter, OBGroup mTargetGroup,
+            const Vec2i& mPos, float mDeg, TArgs... mArgs)
         {
-            for(int i{-mCount}; i <= mCount; ++i)
+            static std::vector<OBPatternShot> shots;
+            shots.clear();
+            evaluatePattern(mWpn.getPattern(), mPos, mDeg, shots);
+            mGame.getProjectiles().reserve(shots.size());
+
+            auto& factory(mGame.getFactory());
+            for(const auto& s : shots)
             {
-                auto& e((mGame.getFactory().*mFactoryAction)(
-                    mShooter, mPos, mDeg + i * mStep));
-                auto& cProjectile(mWpn.shotProjectile(e));
-                cProjectile.setSpeed(
-                    cProjectile.getSpeed() - std::abs(i) * mSpeedChange);
+                auto& e((factory.*mFactoryAction)(
+                    mShooter, s.pos, s.deg, mArgs...));
+                auto& cProjectile(mWpn.shotProjectile(e, mTargetGroup));
+                if(s.speedOffset != 0.f)
+                    cProjectile.setSpeed(
+                        cProjectile.getSpeed() + s.speedOffset);
             }
         }
 
@@ -38,11 +45,12 @@ namespace ob
         {
             return {
                 4.5f, 1.f, 420.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJBullet(
-                        mShooter, mPos, mDeg));
+                    patternShoot(&OBFactory::createPJBullet, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPCaseBullet(1, mMuzzlePxPos, mDeg);
                     mGame.createPMuzzleBullet(16, mMuzzlePxPos);
                 }};
@@ -51,49 +59,57 @@ namespace ob
         {
             return {
                 9.5f, 2.f, 290.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJBoltPlasma(
-                        mShooter, mPos, mDeg));
+                    patternShoot(&OBFactory::createPJBoltPlasma, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPMuzzlePlasma(20, mMuzzlePxPos);
                 }};
         }
         inline OBWpnType createEPlasmaBulletGun(
             int mFanCount = 0, float mStep = 12.f)
         {
-            return {45.f, 0.5f, 320.f, "Sounds/machineGun.wav",
-                [mFanCount, mStep](OBWpnType& mWpn, OBGame& mGame,
-                        OBCActorND* mShooter, const Vec2i& mPos, float mDeg,
-                        const Vec2f& mMuzzlePxPos)
+            OBWpnType result{45.f, 0.5f, 320.f, "Sounds/machineGun.wav",
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
+                    const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    fanShoot(&OBFactory::createPJBulletPlasma, mWpn, mGame,
-                        mShooter, mPos, mDeg, mFanCount, mStep, 40.f);
+                    patternShoot(&OBFactory::createPJBulletPlasma, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPMuzzlePlasma(16, mMuzzlePxPos);
                 }};
+            result.setPattern(
+                {OBPattern::Type::Fan, mFanCount * 2 + 1, mStep, 40.f});
+            return result;
         }
         inline OBWpnType createEPlasmaStarGun(
             int mFanCount = 0, float mStep = 12.f)
         {
-            return {75.f, 1.f, 260.f, "Sounds/machineGun.wav",
-                [mFanCount, mStep](OBWpnType& mWpn, OBGame& mGame,
-                        OBCActorND* mShooter, const Vec2i& mPos, float mDeg,
-                        const Vec2f& mMuzzlePxPos)
+            OBWpnType result{75.f, 1.f, 260.f, "Sounds/machineGun.wav",
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
+                    const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    fanShoot(&OBFactory::createPJStarPlasma, mWpn, mGame,
-                        mShooter, mPos, mDeg, mFanCount, mStep, 40.f);
+                    patternShoot(&OBFactory::createPJStarPlasma, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPMuzzlePlasma(16, mMuzzlePxPos);
                 }};
+            result.setPattern(
+                {OBPattern::Type::Fan, mFanCount * 2 + 1, mStep, 40.f});
+            return result;
         }
         inline OBWpnType createPlasmaCannon()
         {
             return {
                 120.f, 5.f, 180.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJCannonPlasma(
-                        mShooter, mPos, mDeg));
+                    patternShoot(&OBFactory::createPJCannonPlasma, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPMuzzlePlasma(30, mMuzzlePxPos);
                 }};
         }
@@ -101,11 +117,12 @@ namespace ob
         {
             return {
                 80.f, 5.f, 25.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJRocket(
-                        mShooter, mPos, mDeg));
+                    patternShoot(&OBFactory::createPJRocket, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPCaseRocket(1, mMuzzlePxPos, mDeg);
                     mGame.createPMuzzleRocket(14, mMuzzlePxPos);
                 }};
@@ -114,11 +131,12 @@ namespace ob
         {
             return {
                 45.f, 5.f, 180.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJGrenade(
-                        mShooter, mPos, mDeg));
+                    patternShoot(&OBFactory::createPJGrenade, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg);
                     mGame.createPCaseRocket(1, mMuzzlePxPos, mDeg);
                     mGame.createPMuzzleRocket(8, mMuzzlePxPos);
                 }};
@@ -127,14 +145,43 @@ namespace ob
         {
             return {
                 19.5f, 1.7f, 220.f, "Sounds/machineGun.wav",
-                [](OBWpnType& mWpn, OBGame& mGame, OBCActorND* mShooter,
+                [](const OBWpnType& mWpn, OBGame& mGame,
+                    OBCActorND* mShooter, OBGroup mTargetGroup,
                     const Vec2i& mPos, float mDeg, const Vec2f& mMuzzlePxPos)
                 {
-                    mWpn.shotProjectile(mGame.getFactory().createPJShockwave(
-                        mShooter, mPos, mDeg, 3));
+                    patternShoot(&OBFactory::createPJShockwave, mWpn, mGame,
+                        mShooter, mTargetGroup, mPos, mDeg, 3);
                     mGame.createPMuzzleShockwave(20, mMuzzlePxPos);
                 }};
         }
+
+        // Registry of every weapon type, filled with the builtins the
+        // first time it's accessed
+        inline OBWpnRegistry& getRegistry()
+        {
+            static OBWpnRegistry result{[]
+                {
+                    OBWpnRegistry r;
+                    r.add("machineGun", createMachineGun());
+                    r.add("plasmaBolter", createPlasmaBolter());
+                    r.add("plasmaCannon", createPlasmaCannon());
+                    r.add("rocketLauncher", createRocketLauncher());
+                    r.add("grenadeLauncher", createGrenadeLauncher());
+                    r.add("shockwaveGun", createShockwaveGun());
+                    r.add("ePlasmaBulletGun", createEPlasmaBulletGun());
+                    r.add("ePlasmaBulletGunFan1",
+                        createEPlasmaBulletGun(1, 8.f));
+                    r.add("ePlasmaBulletGunFan2",
+                        createEPlasmaBulletGun(2, 8.f));
+                    r.add("ePlasmaBulletGunTurret",
+                        createEPlasmaBulletGun(1, 5.f));
+                    r.add("ePlasmaStarGun", createEPlasmaStarGun());
+
+                    SSVU_ASSERT(r.getCount() == WBuiltinCount);
+                    return r;
+                }()};
+            return result;
+        }
     }
 }
 
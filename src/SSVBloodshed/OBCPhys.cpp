@@ -0,0 +1,66 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBGame.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCEnemy.hpp"
+#include "SSVBloodshed/Components/OBCEnemyTypes.hpp"
+#include "SSVBloodshed/Components/OBCPlayer.hpp"
+#include "SSVBloodshed/Components/OBCShard.hpp"
+#include "SSVBloodshed/Components/OBCProjectile.hpp"
+#include "SSVBloodshed/Components/OBCDamageOnTouch.hpp"
+#include "SSVBloodshed/Components/OBCFloorSmasher.hpp"
+#include "SSVBloodshed/Components/OBCForceField.hpp"
+#include "SSVBloodshed/Components/OBCBulletForceField.hpp"
+#include "SSVBloodshed/Components/OBCBooster.hpp"
+#include "SSVBloodshed/Components/OBWeightable.hpp"
+
+namespace ob
+{
+    // Handlers are called in the same order their components are created
+    // by the factory
+
+    void OBCPhys::dispatchDetection(const DetectionInfo& mDI)
+    {
+        if(auto h = getHandler<OBCProjectile>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCDamageOnTouch>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCFloorSmasher>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCShard>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCForceField>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCBulletForceField>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBCBooster>()) h->handleDetection(mDI);
+        if(auto h = getHandler<OBWeightable>()) h->handleDetection(mDI);
+    }
+
+    void OBCPhys::dispatchResolution(const ResolutionInfo& mRI)
+    {
+        lastResolution = mRI.resolution;
+        if(lastResolution.x > 0)
+            crushedLeft = crushedMax;
+        else if(lastResolution.x < 0)
+            crushedRight = crushedMax;
+        if(lastResolution.y > 0)
+            crushedTop = crushedMax;
+        else if(lastResolution.y < 0)
+            crushedBottom = crushedMax;
+
+        if(auto h = getHandler<OBCEnemy>()) h->handleResolution(mRI);
+        if(auto h = getHandler<OBCEBall>()) h->handleResolution(mRI);
+        if(auto h = getHandler<OBCPlayer>()) h->handleResolution(mRI);
+    }
+
+    void OBCPhys::dispatchPreUpdate()
+    {
+        lastResolution = ssvs::zeroVec2i;
+        if(crushedLeft > 0) --crushedLeft;
+        if(crushedRight > 0) --crushedRight;
+        if(crushedTop > 0) --crushedTop;
+        if(crushedBottom > 0) --crushedBottom;
+
+        if(auto h = getHandler<OBCEnemy>()) h->handlePreUpdate();
+        if(auto h = getHandler<OBCShard>()) h->handlePreUpdate();
+        if(auto h = getHandler<OBWeightable>()) h->handlePreUpdate();
+    }
+}
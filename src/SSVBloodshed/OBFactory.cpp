@@ -10,7 +10,7 @@
 #include "SSVBloodshed/Components/OBCProjectile.hpp"
 #include "SSVBloodshed/Components/OBCParticleEmitter.hpp"
 #include "SSVBloodshed/Components/OBCParticleSystem.hpp"
-#include "SSVBloodshed/Components/OBCFloor.hpp"
+#include "SSVBloodshed/Components/OBCTileLayer.hpp"
 #include "SSVBloodshed/Components/OBCHealth.hpp"
 #include "SSVBloodshed/Components/OBCEnemyTypes.hpp"
 #include "SSVBloodshed/Components/OBCKillable.hpp"
@@ -19,6 +19,7 @@
 #include "SSVBloodshed/Components/OBCIdReceiver.hpp"
 #include "SSVBloodshed/Components/OBCDoor.hpp"
 #include "SSVBloodshed/Components/OBCPPlate.hpp"
+#include "SSVBloodshed/Components/OBCTrail.hpp"
 #include "SSVBloodshed/Components/OBCTrapdoor.hpp"
 #include "SSVBloodshed/Components/OBCShard.hpp"
 #include "SSVBloodshed/Components/OBCSpawner.hpp"
@@ -66,6 +67,7 @@ namespace ob
         auto& cHealth(gt<Entity>(tpl).createComponent<OBCHealth>(mHealth));
         auto& cKillable(gt<Entity>(tpl).createComponent<OBCKillable>(
             gt<OBCPhys>(tpl), cHealth, OBCKillable::Type::Organic));
+        gt<OBCPhys>(tpl).getBodyData().cHealth = &cHealth;
         return ssvu::fwdAsTpl(gt<Entity>(tpl), gt<OBCPhys>(tpl),
             gt<OBCDraw>(tpl), cHealth, cKillable);
     }
@@ -73,8 +75,8 @@ namespace ob
         const Vec2i& mPos, const Vec2i& mSize, int mHealth)
     {
         auto tpl(createKillableBase(mPos, mSize, OBLayer::LEnemy, mHealth));
-        auto& cTargeter(gt<Entity>(tpl).createComponent<OBCTargeter>(
-            gt<OBCPhys>(tpl), OBGroup::GFriendly));
+        auto& cTargeter(
+            gt<Entity>(tpl).createComponent<OBCTargeter>(gt<OBCPhys>(tpl)));
         auto& cBoid(gt<Entity>(tpl).createComponent<OBCBoid>(gt<OBCPhys>(tpl)));
         auto& cEnemy(gt<Entity>(tpl).createComponent<OBCEnemy>(gt<OBCPhys>(tpl),
             gt<OBCDraw>(tpl), gt<OBCKillable>(tpl), cTargeter, cBoid));
@@ -91,11 +93,12 @@ namespace ob
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, mIntRect);
         auto& cProjectile(gt<Entity>(tpl).createComponent<OBCProjectile>(
             mShooter, gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), mSpeed, mDeg));
+        gt<OBCPhys>(tpl).getBodyData().cProjectile = &cProjectile;
         return ssvu::fwdAsTpl(
             gt<Entity>(tpl), gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cProjectile);
     }
     Entity& OBFactory::createETurretBase(const Vec2i& mPos, Dir8 mDir,
-        const sf::IntRect& mIntRect, const OBWpnType& mWpn, float mShootDelay,
+        const sf::IntRect& mIntRect, OBWpnTypeId mWpn, float mShootDelay,
         float mPJDelay, int mShootCount)
     {
         auto tpl(createKillableBase(mPos, {1000, 1000}, OBLayer::LEnemy, 18));
@@ -108,39 +111,51 @@ namespace ob
         return gt<Entity>(tpl);
     }
 
-    Entity& OBFactory::createParticleSystem(RenderTexture& mRenderTexture,
-        bool mClearOnDraw, unsigned char mOpacity, int mDrawPriority,
-        sf::BlendMode mBlendMode)
+    Entity& OBFactory::createParticleSystem(OBParticleSystem& mParticleSystem,
+        RenderTexture& mRenderTexture, bool mClearOnDraw,
+        unsigned char mOpacity, int mDrawPriority, sf::BlendMode mBlendMode)
     {
         auto& result(createEntity(mDrawPriority));
-        result.createComponent<OBCParticleSystem>(mRenderTexture,
-            game.getGameWindow(), mClearOnDraw, mOpacity, mBlendMode);
+        result.createComponent<OBCParticleSystem>(mParticleSystem,
+            mRenderTexture, game.getGameWindow(), mClearOnDraw, mOpacity,
+            mBlendMode);
         return result;
     }
     Entity& OBFactory::createTrail(
-        const Vec2i& mA, const Vec2i& mB, const Color& mColor)
+        const OBCPhys& mSource, int mId, const Color& mColor)
     {
         auto& result(manager.createEntity());
-        result.createComponent<OBCTrail>(game, mA, mB, mColor);
+        result.createComponent<OBCTrail>(
+            game, mSource, mId, mSource.getPosI(), mColor);
+        return result;
+    }
+    Entity& OBFactory::createTileLayer(int mDrawPriority)
+    {
+        auto& result(createEntity(mDrawPriority));
+        result.createComponent<OBCTileLayer>(
+            game.getWorld(), game.getGameWindow(), *assets.txSmall);
         return result;
     }
 
-    Entity& OBFactory::createFloor(const Vec2i& mPos, bool mGrate)
+    void OBFactory::createFloor(const Vec2i& mPos, bool mGrate)
     {
-        auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LFloor));
-        emplaceSpriteByTile(
-            gt<OBCDraw>(tpl), assets.txSmall, assets.getFloorVariant());
-        gt<Entity>(tpl).createComponent<OBCFloor>(
-            gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), mGrate);
-        return gt<Entity>(tpl);
+        auto& tiles(game.getTiles());
+        auto& layer(mGrate ? tiles.getFloorGrate() : tiles.getFloor());
+        auto& tile(layer.emplaceTile(mPos, mGrate ? assets.getFloorGrateVariant()
+                                                  : assets.getFloorVariant()));
+        tile.smashed = mGrate;
+
+        auto& body(layer.createBody(tile, mPos));
+        body.addGroups(OBGroup::GFloor);
+        body.setResolve(false);
     }
-    Entity& OBFactory::createPit(const Vec2i& mPos)
+    void OBFactory::createPit(const Vec2i& mPos)
     {
-        auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LPit, true));
-        emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.pit);
-        gt<OBCPhys>(tpl).getBody().addGroups(
-            OBGroup::GSolidGround, OBGroup::GPit);
-        return gt<Entity>(tpl);
+        auto& layer(game.getTiles().getPit());
+        auto& tile(layer.emplaceTile(mPos, assets.pit));
+        layer.createBody(tile, mPos)
+            .addGroups(OBGroup::GSolidGround, OBGroup::GPit);
+        game.getFlowField().addBlocker(mPos);
     }
     Entity& OBFactory::createTrapdoor(const Vec2i& mPos, bool mPlayerOnly)
     {
@@ -151,14 +166,14 @@ namespace ob
             gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), mPlayerOnly);
         return gt<Entity>(tpl);
     }
-    Entity& OBFactory::createWall(
-        const Vec2i& mPos, const sf::IntRect& mIntRect)
+    void OBFactory::createWall(const Vec2i& mPos, const sf::IntRect& mIntRect)
     {
-        auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, true));
-        emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, mIntRect);
-        gt<OBCPhys>(tpl).getBody().addGroups(
-            OBGroup::GSolidGround, OBGroup::GSolidAir);
-        return gt<Entity>(tpl);
+        auto& layer(game.getTiles().getWall());
+        auto& tile(layer.emplaceTile(mPos, mIntRect));
+        layer.createBody(tile, mPos)
+            .addGroups(OBGroup::GSolidGround, OBGroup::GSolidAir);
+        game.getFlowField().addBlocker(mPos);
+        game.getSightGrid().addBlocker(mPos);
     }
     Entity& OBFactory::createWallDestructible(
         const Vec2i& mPos, const sf::IntRect& mIntRect)
@@ -170,6 +185,15 @@ namespace ob
             OBGroup::GEnemyKillable, OBGroup::GEnvDestructible);
         gt<OBCPhys>(tpl).getBody().setStatic(true);
         gt<OBCKillable>(tpl).setType(OBCKillable::Type::Wall);
+
+        game.getFlowField().addBlocker(mPos);
+        game.getSightGrid().addBlocker(mPos);
+        gt<OBCKillable>(tpl).onDeath += [this, mPos]
+        {
+            game.getFlowField().removeBlocker(mPos);
+            game.getSightGrid().removeBlocker(mPos);
+        };
+
         return gt<Entity>(tpl);
     }
     Entity& OBFactory::createDoor(
@@ -177,7 +201,8 @@ namespace ob
     {
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, true));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, mIntRect);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
         gt<Entity>(tpl).createComponent<OBCDoor>(
             gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mOpen);
         return gt<Entity>(tpl);
@@ -201,7 +226,7 @@ namespace ob
         return gt<Entity>(tpl);
     }
     Entity& OBFactory::createPPlate(const Vec2i& mPos, int mId,
-        PPlateType mType, IdAction mIdAction, bool mPlayerOnly)
+        PPlateType mType, IdAction mIdAction, bool mPlayerOnly, int mCluster)
     {
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LFloor));
         const auto& intRect(
@@ -210,8 +235,10 @@ namespace ob
                 : (mType == PPlateType::Multi ? assets.pPlateMulti
                                               : assets.pPlateOnOff));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, intRect);
-        gt<Entity>(tpl).createComponent<OBCPPlate>(gt<OBCPhys>(tpl),
-            gt<OBCDraw>(tpl), mId, mType, mIdAction, mPlayerOnly);
+        auto& cPPlate(gt<Entity>(tpl).createComponent<OBCPPlate>(
+            gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), mId, mType, mIdAction,
+            mPlayerOnly, mCluster));
+        gt<OBCPhys>(tpl).getBodyData().cPPlate = &cPPlate;
         return gt<Entity>(tpl);
     }
     Entity& OBFactory::createPlayer(const Vec2i& mPos)
@@ -225,8 +252,10 @@ namespace ob
                 gt<OBCDraw>(tpl), cDir8, assets.p1Stand, assets.p1Shoot));
         auto& cWpnController(gt<Entity>(tpl).createComponent<OBCWpnController>(
             gt<OBCPhys>(tpl), OBGroup::GEnemyKillable));
-        gt<Entity>(tpl).createComponent<OBCPlayer>(gt<OBCPhys>(tpl),
-            gt<OBCDraw>(tpl), gt<OBCKillable>(tpl), cWielder, cWpnController);
+        auto& cPlayer(gt<Entity>(tpl).createComponent<OBCPlayer>(
+            gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), gt<OBCKillable>(tpl), cWielder,
+            cWpnController));
+        gt<OBCPhys>(tpl).getBodyData().cPlayer = &cPlayer;
         return gt<Entity>(tpl);
     }
     Entity& OBFactory::createExplosiveCrate(const Vec2i& mPos, int mId)
@@ -234,7 +263,8 @@ namespace ob
         auto tpl(createKillableBase(mPos, {1000, 1000}, OBLayer::LWall, 10));
         emplaceSpriteByTile(
             gt<OBCDraw>(tpl), assets.txSmall, assets.explosiveCrate);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
         gt<OBCPhys>(tpl).getBody().addGroups(OBGroup::GSolidGround,
             OBGroup::GSolidAir, OBGroup::GKillable, OBGroup::GFriendlyKillable,
             OBGroup::GEnemyKillable, OBGroup::GEnvDestructible);
@@ -245,9 +275,13 @@ namespace ob
         {
             gt<OBCKillable>(tpl).kill();
         };
-        gt<OBCKillable>(tpl).onDeath += [this, tpl]
+        game.getFlowField().addBlocker(mPos);
+        game.getSightGrid().addBlocker(mPos);
+        gt<OBCKillable>(tpl).onDeath += [this, tpl, mPos]
         {
-            deathExplode(nullptr, tpl, 16);
+            game.getFlowField().removeBlocker(mPos);
+            game.getSightGrid().removeBlocker(mPos);
+            deathExplode(nullptr, gt<OBCPhys>(tpl).getPosI(), 16);
         };
 
         return gt<Entity>(tpl);
@@ -265,7 +299,8 @@ namespace ob
     {
         auto tpl(createActorBase(mPos, {400, 400}, OBLayer::LShard));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.spawner);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
         auto& cSpawner(gt<Entity>(tpl).createComponent<OBCSpawner>(
             gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mType, mDelayStart,
             mDelaySpawn, mSpawnCount));
@@ -278,10 +313,13 @@ namespace ob
     {
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.ff0);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
-        gt<Entity>(tpl).createComponent<OBCForceField>(gt<OBCPhys>(tpl),
-            gt<OBCDraw>(tpl), cIdReceiver, mDir, mBlockFriendly, mBlockEnemy,
-            mForceMult);
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
+        auto& cForceField(gt<Entity>(tpl).createComponent<OBCForceField>(
+            gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir,
+            mBlockFriendly, mBlockEnemy, mForceMult));
+        gt<OBCPhys>(tpl).getBodyData().cForceField = &cForceField;
+        game.getSightGrid().addField(mPos, getRadFromDir8(mDir), false);
         gt<OBCDraw>(tpl).setBlendMode(sf::BlendAdd);
         sf::Color color{225, 0, 0, 255};
         color.g = 255 * ssvu::toInt(mBlockFriendly);
@@ -304,9 +342,14 @@ namespace ob
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
         emplaceSpriteByTile(
             gt<OBCDraw>(tpl), assets.txSmall, assets.forceArrowMark);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
-        gt<Entity>(tpl).createComponent<OBCBulletForceField>(gt<OBCPhys>(tpl),
-            gt<OBCDraw>(tpl), cIdReceiver, mDir, mBlockFriendly, mBlockEnemy);
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
+        auto& cBulletForceField(
+            gt<Entity>(tpl).createComponent<OBCBulletForceField>(
+                gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir,
+                mBlockFriendly, mBlockEnemy));
+        gt<OBCPhys>(tpl).getBodyData().cBulletForceField = &cBulletForceField;
+        game.getSightGrid().addField(mPos, getRadFromDir8(mDir), true);
         gt<OBCDraw>(tpl).setBlendMode(sf::BlendAdd);
 
         sf::Color color{255, 0, 0, 255};
@@ -322,7 +365,8 @@ namespace ob
     {
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.ff0);
-        auto& cIdReceiver(gt<Entity>(tpl).createComponent<OBCIdReceiver>(mId));
+        auto& cIdReceiver(
+            gt<Entity>(tpl).createComponent<OBCIdReceiver>(game, mId));
         gt<Entity>(tpl).createComponent<OBCBooster>(
             gt<OBCPhys>(tpl), gt<OBCDraw>(tpl), cIdReceiver, mDir, mForceMult);
         gt<OBCDraw>(tpl).setBlendMode(sf::BlendAdd);
@@ -416,22 +460,22 @@ namespace ob
     Entity& OBFactory::createETurretStarPlasma(const Vec2i& mPos, Dir8 mDir)
     {
         return createETurretBase(mPos, mDir, assets.eTurret0,
-            OBWpnTypes::createEPlasmaStarGun(), 125.f, 5.f, 3);
+            WEPlasmaStarGun, 125.f, 5.f, 3);
     }
     Entity& OBFactory::createETurretCannonPlasma(const Vec2i& mPos, Dir8 mDir)
     {
         return createETurretBase(mPos, mDir, assets.eTurret1,
-            OBWpnTypes::createPlasmaCannon(), 125.f, 5.f, 1);
+            WPlasmaCannon, 125.f, 5.f, 1);
     }
     Entity& OBFactory::createETurretBulletPlasma(const Vec2i& mPos, Dir8 mDir)
     {
         return createETurretBase(mPos, mDir, assets.eTurret2,
-            OBWpnTypes::createEPlasmaBulletGun(1, 5.f), 125.f, 2.f, 4);
+            WEPlasmaBulletGunTurret, 125.f, 2.f, 4);
     }
     Entity& OBFactory::createETurretRocket(const Vec2i& mPos, Dir8 mDir)
     {
         return createETurretBase(mPos, mDir, assets.eTurret3,
-            OBWpnTypes::createRocketLauncher(), 250.f, 0.f, 1);
+            WRocketLauncher, 250.f, 0.f, 1);
     }
 
 
@@ -521,7 +565,7 @@ namespace ob
         gt<OBCProjectile>(tpl).setAcceleration(3.5f);
         gt<OBCProjectile>(tpl).onDestroy += [this, tpl, mShooter]
         {
-            deathExplode(mShooter, tpl, 16);
+            deathExplode(mShooter, gt<OBCPhys>(tpl).getPosI(), 16);
         };
         return gt<Entity>(tpl);
     }
@@ -539,7 +583,7 @@ namespace ob
         gt<OBCProjectile>(tpl).setFallInPit(true);
         gt<OBCProjectile>(tpl).onDestroy += [this, tpl, mShooter]
         {
-            deathExplode(mShooter, tpl, 16, 0.5f);
+            deathExplode(mShooter, gt<OBCPhys>(tpl).getPosI(), 16, 0.5f);
         };
         return gt<Entity>(tpl);
     }
@@ -622,12 +666,39 @@ namespace ob
         return gt<Entity>(tpl);
     }
 
+    void OBFactory::createDeathExplosion(OBCActorND* mShooter,
+        const Vec2i& mPos, SizeT mCount, float mRangeMult)
+    {
+        auto& cp(createPJExplosion(mShooter, mPos, 0, 0)
+                     .getComponent<OBCProjectile>());
+        cp.setTargetGroup(OBGroup::GKillable);
+        cp.setLife(16.f * mRangeMult);
+        cp.setKillDestructible(true);
+
+        SSVU_ASSERT(mCount != 0);
+        for(int i{0}; i < 360; i += 360 / mCount)
+        {
+            auto& cpMv(createPJExplosion(mShooter,
+                           mPos + Vec2i(ssvs::getVecFromDeg(i, 251.f)), i)
+                           .getComponent<OBCProjectile>());
+            cpMv.setTargetGroup(OBGroup::GKillable);
+            cpMv.setLife(16.f * mRangeMult);
+            cpMv.setKillDestructible(true);
+        }
+    }
+    void OBFactory::deathExplode(OBCActorND* mShooter, const Vec2i& mPos,
+        SizeT mCount, float mRangeMult)
+    {
+        game.getCommands().explode(mShooter, mPos, mCount, mRangeMult);
+    }
+
     Entity& OBFactory::createVMHealth(const Vec2i& mPos)
     {
         auto tpl(createActorBase(mPos, {1000, 1000}, OBLayer::LWall, false));
         emplaceSpriteByTile(gt<OBCDraw>(tpl), assets.txSmall, assets.vmHealth);
         gt<OBCPhys>(tpl).getBody().addGroups(
             OBGroup::GSolidGround, OBGroup::GSolidAir);
+        game.getSightGrid().addBlocker(mPos);
         auto& cUsable(
             gt<Entity>(tpl).createComponent<OBCUsable>(gt<OBCPhys>(tpl)));
         gt<Entity>(tpl).createComponent<OBCVMachine>(gt<OBCDraw>(tpl), cUsable);
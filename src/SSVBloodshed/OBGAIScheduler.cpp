@@ -0,0 +1,60 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGAIScheduler.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCEnemyTypes.hpp"
+
+namespace ob
+{
+    void OBGAIScheduler::add(OBCEBase& mMember)
+    {
+        mMember.memberIdx = members.size();
+        members.emplace_back(&mMember);
+    }
+
+    void OBGAIScheduler::remove(OBCEBase& mMember)
+    {
+        auto idx(mMember.memberIdx), last(members.size() - 1);
+        SSVU_ASSERT(idx <= last && members[idx] == &mMember);
+
+        members[idx] = members[last];
+        members[idx]->memberIdx = idx;
+        members.pop_back();
+    }
+
+    void OBGAIScheduler::refresh(FT mFT)
+    {
+        int thinksLeft{thinkBudget};
+        agents.resize(members.size());
+
+        for(auto i(0u); i < members.size(); ++i)
+        {
+            auto& m(*members[i]);
+            m.aiIdx = i;
+            m.cTargeter.setAIIdx(i);
+
+            auto& a(agents[i]);
+            a.pos = m.cPhys.getPosF();
+            a.vel = m.cPhys.getVel();
+            a.posI = m.cPhys.getPosI();
+            a.currentDeg = m.cEnemy.getCurrentDeg();
+            a.maxVel = m.cBoid.getMaxVel();
+            a.evadeDist = m.evadeDist;
+            a.mind = m.mind;
+            a.armed = m.isArmed();
+            a.last = m.decision;
+
+            m.thinkElapsed += mFT;
+            m.thinkTimer -= mFT;
+
+            a.thinks = a.mind != Mind::None && m.thinkTimer <= 0.f &&
+                       (thinksLeft > 0 || m.thinkElapsed >= maxThinkWait);
+            if(!a.thinks) continue;
+
+            --thinksLeft;
+            m.thinkElapsed = 0.f;
+        }
+    }
+}
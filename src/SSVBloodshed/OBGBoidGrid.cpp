@@ -0,0 +1,26 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGBoidGrid.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCBoid.hpp"
+
+namespace ob
+{
+    void OBGBoidGrid::refresh()
+    {
+        agents.resize(members.size());
+        for(auto i(0u); i < members.size(); ++i)
+        {
+            auto& b(*members[i]);
+            const auto& cPhys(b.getCPhys());
+            agents[i] = {cPhys.getPosF(), cPhys.getVel(), b.getMaxVel(),
+                b.getNeighborRadius(), b.getSeparationMult(),
+                b.getCohesionMult()};
+            b.setGridIdx(i);
+        }
+
+        sortAgents();
+    }
+}
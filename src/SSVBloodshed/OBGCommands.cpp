@@ -0,0 +1,57 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGCommands.hpp"
+#include "SSVBloodshed/OBGame.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCPlayer.hpp"
+
+namespace ob
+{
+    void OBGCommands::apply(OBGame& mGame)
+    {
+        auto& factory(mGame.getFactory());
+
+        // A reload destroys every entity the other commands refer to -
+        // they're only dropped if the level was actually reloaded
+        if(levelChangePending)
+        {
+            levelChangePending = false;
+
+            const auto& lc(levelChange);
+            if(mGame.enterLevel(lc.x, lc.y))
+            {
+                factory.createPlayer(lc.playerData.pos)
+                    .getComponent<OBCPlayer>()
+                    .initFromData(lc.playerData);
+
+                clear();
+                return;
+            }
+        }
+
+        // Applying a command may record new ones, which are then applied
+        // in the same pass
+        for(auto i(0u); i < explosions.size(); ++i)
+        {
+            const auto c(explosions[i]);
+            factory.createDeathExplosion(
+                c.shooter, c.pos, c.count, c.rangeMult);
+        }
+        for(auto i(0u); i < eBallSpawns.size(); ++i)
+        {
+            const auto c(eBallSpawns[i]);
+            factory.createEBall(c.pos, c.type, true)
+                .getComponent<OBCPhys>()
+                .setVel(c.vel);
+        }
+        for(auto i(0u); i < shardSpawns.size(); ++i)
+        {
+            const auto c(shardSpawns[i]);
+            mGame.createEShard(c.count, c.pos);
+        }
+
+        clear();
+    }
+}
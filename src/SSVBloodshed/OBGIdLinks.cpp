@@ -0,0 +1,45 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGIdLinks.hpp"
+#include "SSVBloodshed/OBGame.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCIdReceiver.hpp"
+#include "SSVBloodshed/Components/OBCTrail.hpp"
+
+namespace ob
+{
+    void OBGIdLinks::activate(OBCPhys& mSource, int mId, IdAction mIdAction)
+    {
+        static sf::Color actionColors[]{
+            sf::Color::Yellow, sf::Color::Green, sf::Color::Red};
+        const auto& color(actionColors[int(mIdAction)]);
+
+        auto itr(receivers.find(mId));
+        if(itr == std::end(receivers) || itr->second.empty()) return;
+
+        OBCTrail* trail;
+        auto tItr(trails.find({&mSource, mId}));
+        if(tItr != std::end(trails))
+        {
+            trail = tItr->second;
+            trail->restart(mSource.getPosI(), color);
+        }
+        else
+            trail = &mSource.getFactory()
+                         .createTrail(mSource, mId, color)
+                         .getComponent<OBCTrail>();
+
+        // Activations can spawn new receivers - the list is indexed so that
+        // it can safely grow meanwhile
+        const auto& list(itr->second);
+        for(auto i(0u); i < list.size(); ++i)
+        {
+            auto& cIdReceiver(*list[i]);
+            cIdReceiver.activate(mIdAction);
+            trail->addTarget(
+                cIdReceiver.getEntity().getComponent<OBCPhys>().getPosI());
+        }
+    }
+}
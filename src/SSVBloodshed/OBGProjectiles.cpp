@@ -0,0 +1,77 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGProjectiles.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCProjectile.hpp"
+
+namespace ob
+{
+    void OBGProjectiles::add(OBCProjectile& mProjectile)
+    {
+        mProjectile.projectileIdx = members.size();
+        members.emplace_back(&mProjectile);
+        flights.emplace_back();
+        lives.emplace_back();
+        alive.emplace_back(true);
+    }
+
+    void OBGProjectiles::remove(OBCProjectile& mProjectile)
+    {
+        auto idx(mProjectile.projectileIdx), last(members.size() - 1);
+        SSVU_ASSERT(idx <= last && members[idx] == &mProjectile);
+
+        if(idx != last)
+        {
+            members[idx] = members[last];
+            members[idx]->projectileIdx = idx;
+            flights[idx] = flights[last];
+            lives[idx] = lives[last];
+            alive[idx] = alive[last];
+        }
+
+        members.pop_back();
+        flights.pop_back();
+        lives.pop_back();
+        alive.pop_back();
+    }
+
+    void OBGProjectiles::update(FT mFT)
+    {
+        const auto count(members.size());
+        velocities.resize(count);
+        expired.clear();
+
+        for(auto i(0u); i < count; ++i)
+            velocities[i] = members[i]->getCPhys().getBody().getVelocity();
+
+        // Steer and age every projectile from the flat arrays alone...
+        for(auto i(0u); i < count; ++i)
+        {
+            if(!alive[i]) continue;
+
+            const auto& f(flights[i]);
+            auto& v(velocities[i]);
+            ssvs::resize(v, ssvs::getMag(v) + f.acceleration * mFT);
+            ssvs::mClamp(v, f.minSpeed, f.maxSpeed);
+            v = ssvs::getVecFromRad(
+                ssvs::getRad(v) + f.curveSpeed * mFT, ssvs::getMag(v));
+
+            auto& l(lives[i]);
+            l.current += mFT;
+            if(l.current < l.max) continue;
+
+            l.current = 0.f;
+            expired.emplace_back(i);
+        }
+
+        // ...then write the velocities back to the bodies, and destroy the
+        // expired projectiles, which may spawn new ones
+        for(auto i(0u); i < count; ++i)
+            if(alive[i])
+                members[i]->getCPhys().getBody().setVelocity(velocities[i]);
+
+        for(auto i : expired) members[i]->destroy();
+    }
+}
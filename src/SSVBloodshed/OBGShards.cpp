@@ -0,0 +1,134 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGShards.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+#include "SSVBloodshed/Components/OBCPlayer.hpp"
+#include "SSVBloodshed/Components/OBCShard.hpp"
+
+namespace ob
+{
+    void OBGShards::add(OBCShard& mShard)
+    {
+        const auto& cPhys(mShard.getCPhys());
+        mShard.shardIdx = members.size();
+        members.emplace_back(&mShard);
+        positions.emplace_back(cPhys.getPosF());
+        velocities.emplace_back(cPhys.getVel());
+    }
+
+    void OBGShards::remove(OBCShard& mShard)
+    {
+        auto idx(mShard.shardIdx), last(members.size() - 1);
+        SSVU_ASSERT(idx <= last && members[idx] == &mShard);
+
+        if(idx != last)
+        {
+            members[idx] = members[last];
+            members[idx]->shardIdx = idx;
+            positions[idx] = positions[last];
+            velocities[idx] = velocities[last];
+        }
+
+        members.pop_back();
+        positions.pop_back();
+        velocities.pop_back();
+    }
+
+    void OBGShards::refresh()
+    {
+        for(auto i(0u); i < members.size(); ++i)
+        {
+            const auto& cPhys(members[i]->getCPhys());
+            positions[i] = cPhys.getPosF();
+            velocities[i] = cPhys.getVel();
+        }
+
+        merge();
+    }
+
+    void OBGShards::merge()
+    {
+        resting.clear();
+        for(auto i(0u); i < members.size(); ++i)
+            if(members[i]->getValue() < maxValue &&
+                ssvs::getMag(velocities[i]) < restSpeed)
+                resting.emplace_back(i);
+
+        // Sweep along the x axis: only shards closer than `mergeDist`
+        // horizontally are ever compared
+        ssvu::sort(resting, [this](SizeT mA, SizeT mB)
+            {
+                return positions[mA].x < positions[mB].x;
+            });
+
+        for(auto i(0u); i < resting.size(); ++i)
+        {
+            auto& a(*members[resting[i]]);
+            const auto& aPos(positions[resting[i]]);
+
+            for(auto j(i + 1); j < resting.size(); ++j)
+            {
+                const auto& bPos(positions[resting[j]]);
+                if(bPos.x - aPos.x > mergeDist) break;
+                if(a.getValue() == 0 || a.getValue() >= maxValue) break;
+
+                auto& b(*members[resting[j]]);
+                if(b.getValue() == 0 ||
+                    a.getValue() + b.getValue() > maxValue ||
+                    ssvs::getDistEuclidean(aPos, bPos) > mergeDist)
+                    continue;
+
+                a.absorb(b);
+            }
+        }
+    }
+
+    void OBGShards::attract(const Vec2i& mPos, bool mLevelClear)
+    {
+        const Vec2f target(mPos);
+        const auto count(members.size());
+        pulls.resize(count);
+        pullTypes.resize(count);
+
+        // Decide every pull from the snapshot alone...
+        for(auto i(0u); i < count; ++i)
+        {
+            Vec2f toTarget{target - positions[i]};
+            auto dist(ssvs::getMag(toTarget));
+
+            if(!mLevelClear)
+            {
+                pullTypes[i] = dist <= 3500.f ? Pull::Accel : Pull::None;
+                pulls[i] = toTarget * 0.004f;
+            }
+            else if(dist > 6500.f)
+            {
+                pullTypes[i] = ssvs::getMag(velocities[i]) < 650.f
+                                   ? Pull::Accel
+                                   : Pull::None;
+                pulls[i] = toTarget * 0.002f;
+            }
+            else
+            {
+                pullTypes[i] = Pull::Vel;
+                pulls[i] = ssvs::getMClampedMax(toTarget / 1.5f, 400.f);
+            }
+        }
+
+        // ...then apply them to the bodies in a second pass
+        for(auto i(0u); i < count; ++i)
+        {
+            if(members[i]->getValue() == 0) continue;
+
+            auto& body(members[i]->getCPhys().getBody());
+            if(mLevelClear) body.addGroupsNoResolve(OBGroup::GSolidGround);
+
+            if(pullTypes[i] == Pull::Accel)
+                body.applyAccel(pulls[i]);
+            else if(pullTypes[i] == Pull::Vel)
+                body.setVelocity(pulls[i]);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVBloodshed/OBGTargetRegistry.hpp"
+#include "SSVBloodshed/Components/OBCPhys.hpp"
+
+namespace ob
+{
+    void OBGTargetRegistry::refresh(sses::Manager& mManager)
+    {
+        for(auto& s : slots) s.alive = s.alive && mManager.isAlive(s.stat);
+
+        for(const auto& e : mManager.getEntities(OBGroup::GFriendly))
+        {
+            auto& cPhys(e->getComponent<OBCPhys>());
+            auto stat(e->getStat());
+
+            auto itr(std::find_if(std::begin(slots), std::end(slots),
+                [&cPhys](const Slot& mS)
+                {
+                    return mS.alive && mS.cPhys == &cPhys;
+                }));
+
+            if(itr == std::end(slots))
+                itr = std::find_if(std::begin(slots), std::end(slots),
+                    [](const Slot& mS)
+                    {
+                        return !mS.alive;
+                    });
+
+            if(itr == std::end(slots))
+            {
+                slots.emplace_back();
+                itr = std::end(slots) - 1;
+            }
+
+            *itr = {&cPhys, stat, cPhys.getPosI(), cPhys.getPosF(),
+                cPhys.getVel(), true};
+        }
+    }
+}
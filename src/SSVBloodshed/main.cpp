@@ -39,6 +39,7 @@ int main()
 
 
     auto assets(mkUPtr<OBAssets>());
+    OBWpnTypes::getRegistry();
     auto game(mkUPtr<OBGame>(gameWindow, *assets));
     auto editor(mkUPtr<OBLEEditor>(gameWindow, *assets));
     auto database(mkUPtr<OBLEDatabase>(*assets));
@@ -0,0 +1,51 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Offline level baker - reads a pack of either format and writes its baked
+// levels, by default to `<pack>.baked`, where the game looks for them
+//
+// Baking only needs the pack and the spawn schemas, so the baker can run
+// as a build step on machines without a display
+
+#include <iostream>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBinary.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBake.hpp"
+
+using namespace ob;
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: OBBaker <pack> [<output>]\n";
+        return 1;
+    }
+
+    std::string packPath{argv[1]};
+    std::string outPath{argc == 3 ? argv[2] : packPath + ".baked"};
+
+    try
+    {
+        OBWorkers workers{std::max(1u, std::thread::hardware_concurrency())};
+        auto pack(OBLEBinary::readPack(packPath, workers));
+        auto baked(OBLEBakedPack::bake(pack));
+
+        OBLEBinary::replaceFile(outPath, [&baked](const std::string& mTmp)
+            {
+                baked.writeToFile(mTmp);
+            });
+
+        std::cout << "Baked " << baked.getLevelCount() << " levels of "
+                  << packPath << " into " << outPath << std::endl;
+    }
+    catch(const std::exception& mError)
+    {
+        std::cerr << "OBBaker: " << mError.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
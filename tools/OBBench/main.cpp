@@ -0,0 +1,453 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Headless benchmarks - runs every benchmark, or only the ones named on the
+// command line, and prints their timings
+//
+// Benchmarks drive the game's data structures with generated data and
+// stand-ins for components - the pack benchmarks read the shipped packs,
+// so they are run from `_RELEASE`
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <tuple>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/OBGBoidGrid.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBinary.hpp"
+
+using namespace ob;
+
+namespace
+{
+    // Live and peak bytes allocated through the global operator new
+    std::atomic<SizeT> heapNow{0}, heapPeak{0};
+    constexpr SizeT heapHeader{alignof(std::max_align_t)};
+}
+
+// Allocations are prefixed with their size, so that frees can be counted
+void* operator new(std::size_t mSize)
+{
+    auto p(static_cast<char*>(std::malloc(mSize + heapHeader)));
+    if(p == nullptr) throw std::bad_alloc{};
+    *reinterpret_cast<std::size_t*>(p) = mSize;
+
+    auto now(heapNow += mSize);
+    auto peak(heapPeak.load());
+    while(now > peak && !heapPeak.compare_exchange_weak(peak, now))
+        ;
+
+    return p + heapHeader;
+}
+void operator delete(void* mPtr) noexcept
+{
+    if(mPtr == nullptr) return;
+    auto p(static_cast<char*>(mPtr) - heapHeader);
+    heapNow -= *reinterpret_cast<std::size_t*>(p);
+    std::free(p);
+}
+void operator delete(void* mPtr, std::size_t) noexcept
+{
+    operator delete(mPtr);
+}
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    template <typename TF>
+    inline double getMs(const TF& mFn)
+    {
+        auto start(Clock::now());
+        mFn();
+        return std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    }
+
+    inline void report(const std::string& mName, double mMs)
+    {
+        std::cout << "    " << mName << ": " << mMs << " ms" << std::endl;
+    }
+
+    // Body event dispatch, in the two shapes OBCPhys has had: one delegate
+    // entry per handler component, and a single entry dispatching to a
+    // tuple of typed handler pointers
+    //
+    // The handlers stand in for the game's components, which need a
+    // running game to be constructed - this compares the two dispatch
+    // shapes, it doesn't time OBCPhys itself
+    namespace Dispatch
+    {
+        struct Info
+        {
+            int resolution;
+        };
+
+        struct Enemy
+        {
+            int vel{0};
+            inline void handleResolution(const Info& mI)
+            {
+                vel -= mI.resolution;
+            }
+        };
+        struct Player
+        {
+            int crushed{0};
+            inline void handleResolution(const Info& mI)
+            {
+                if(mI.resolution > 0) ++crushed;
+            }
+        };
+        struct Weightable
+        {
+            int weight{0};
+            inline void handleResolution(const Info& mI)
+            {
+                weight += mI.resolution & 1;
+            }
+        };
+
+        struct DelegateBody
+        {
+            ssvu::Delegate<void(const Info&)> onResolution;
+        };
+
+        struct StaticBody
+        {
+            ssvu::Delegate<void(const Info&)> onResolution;
+            std::tuple<Enemy*, Player*, Weightable*> handlers{};
+
+            inline void dispatchResolution(const Info& mI)
+            {
+                if(auto h = std::get<Enemy*>(handlers))
+                    h->handleResolution(mI);
+                if(auto h = std::get<Player*>(handlers))
+                    h->handleResolution(mI);
+                if(auto h = std::get<Weightable*>(handlers))
+                    h->handleResolution(mI);
+            }
+        };
+    }
+
+    void benchDispatch()
+    {
+        using namespace Dispatch;
+
+        constexpr SizeT bodyCount{4000}, frameCount{1000};
+
+        std::vector<Enemy> enemies(bodyCount);
+        std::vector<Player> players(bodyCount);
+        std::vector<Weightable> weightables(bodyCount);
+
+        std::vector<DelegateBody> delegateBodies(bodyCount);
+        std::vector<StaticBody> staticBodies(bodyCount);
+
+        for(auto i(0u); i < bodyCount; ++i)
+        {
+            auto& e(enemies[i]);
+            auto& p(players[i]);
+            auto& w(weightables[i]);
+
+            auto& db(delegateBodies[i]);
+            db.onResolution += [&e](const Info& mI)
+            {
+                e.handleResolution(mI);
+            };
+            db.onResolution += [&p](const Info& mI)
+            {
+                p.handleResolution(mI);
+            };
+            db.onResolution += [&w](const Info& mI)
+            {
+                w.handleResolution(mI);
+            };
+
+            auto& sb(staticBodies[i]);
+            sb.handlers = std::make_tuple(&e, &p, &w);
+            sb.onResolution += [&sb](const Info& mI)
+            {
+                sb.dispatchResolution(mI);
+            };
+        }
+
+        auto run([frameCount](auto& mBodies)
+            {
+                return getMs([frameCount, &mBodies]
+                    {
+                        for(auto f(0u); f < frameCount; ++f)
+                            for(auto& b : mBodies)
+                                b.onResolution(Info{int(f) - 500});
+                    });
+            });
+
+        std::cout << "Dispatching " << bodyCount * frameCount
+                  << " resolution events to 3 stand-in handlers each"
+                  << std::endl;
+        report("delegate per handler", run(delegateBodies));
+        report("static dispatch", run(staticBodies));
+
+        // Keeps the handlers' work observable
+        long long sum{0};
+        for(auto i(0u); i < bodyCount; ++i)
+            sum += enemies[i].vel + players[i].crushed + weightables[i].weight;
+        std::cout << "    (checksum " << sum << ")" << std::endl;
+    }
+
+    // Flocking of a swarm of boids through the boid grid, against every
+    // boid measuring its distance to every other one
+    //
+    // The boids are agents fed to the grid directly, moved by their
+    // steering every frame, and start in a few clusters like spawned
+    // swarms do
+    void benchBoids()
+    {
+        constexpr SizeT boidCount{500}, frameCount{1000};
+        constexpr float radius{1500.f};
+
+        std::vector<OBGBoidGrid::Agent> start(boidCount);
+        for(auto i(0u); i < boidCount; ++i)
+        {
+            Vec2f center{levelWidthCoords * (i % 4 + 1) / 5.f,
+                levelHeightCoords * (i % 3 + 1) / 4.f};
+            start[i] = {center + Vec2f{ssvu::getRndF(-3000.f, 3000.f),
+                                     ssvu::getRndF(-3000.f, 3000.f)},
+                ssvs::zeroVec2f, 150.f, radius, 0.06f, 0.005f};
+        }
+
+        auto runGrid([&start](OBWorkers& mWorkers)
+            {
+                return getMs([&start, &mWorkers]
+                    {
+                        OBGBoidGrid grid;
+                        auto agents(start);
+                        for(auto f(0u); f < frameCount; ++f)
+                        {
+                            grid.refresh(agents);
+                            grid.decide(mWorkers);
+                            for(auto i(0u); i < boidCount; ++i)
+                            {
+                                auto& a(agents[i]);
+                                a.vel += grid.getSteering(i);
+                                a.pos += a.vel;
+                            }
+                        }
+                    });
+            });
+
+        std::cout << "Flocking " << boidCount << " boids for " << frameCount
+                  << " frames" << std::endl;
+
+        SizeT inRange{0};
+        auto allPairsMs(getMs([&start, &inRange]
+            {
+                for(auto f(0u); f < frameCount; ++f)
+                    for(const auto& a : start)
+                        for(const auto& b : start)
+                            inRange +=
+                                ssvs::getDistEuclidean(a.pos, b.pos) <= radius;
+            }));
+        report("all pairs", allPairsMs);
+
+        OBWorkers serial{1};
+        report("grid, 1 thread", runGrid(serial));
+        OBWorkers workers{std::max(1u, std::thread::hardware_concurrency())};
+        report("grid, all threads", runGrid(workers));
+
+        // Keeps the all pairs scan observable
+        std::cout << "    (" << inRange << " pairs in range)" << std::endl;
+    }
+
+    // Peak heap growth while running `mFn`
+    template <typename TF>
+    inline SizeT getPeakBytes(const TF& mFn)
+    {
+        auto base(heapNow.load());
+        heapPeak = base;
+        mFn();
+        return heapPeak - base;
+    }
+
+    inline void reportPack(const std::string& mName, double mMs,
+        SizeT mPeakBytes, SizeT mFileBytes)
+    {
+        report(mName, mMs);
+        std::cout << "        " << mFileBytes / 1024.0 / 1024.0 / mMs * 1000.0
+                  << " MB/s, peak heap " << mPeakBytes / 1024 / 1024 << " MB"
+                  << std::endl;
+    }
+
+    // The loader JSON packs had before `OBLEJsonReader`: a DOM of the whole
+    // file, converted to the pack layout, converted to levels
+    inline OBLEPack loadPackDom(const std::string& mPath)
+    {
+        auto jPack(ssvj::fromFile(mPath).as<OBLEJsonPack>());
+
+        OBLEPack result;
+        result.setName(jPack.name);
+        for(const auto& s : jPack.sectors)
+            for(const auto& l : s.second.levels)
+            {
+                const auto& jl(l.second);
+                OBLELevel level{jl.x, jl.y, jl.cols, jl.rows, jl.depth};
+                for(const auto& t : jl.tiles) level.set(t.second);
+                result.getSector(s.first).getLevels()[l.first] =
+                    ssvu::mv(level);
+            }
+
+        return result;
+    }
+
+    inline SizeT getFileBytes(const std::string& mPath)
+    {
+        std::ifstream ifs{mPath, std::ios::binary | std::ios::ate};
+        return SizeT(ifs.tellg());
+    }
+
+    // Writes a JSON pack made of `mCopies` copies of the shipped pack's
+    // levels, and returns its size
+    inline SizeT writeLargePack(const std::string& mPath, int mCopies)
+    {
+        auto shipped(OBLEBinary::loadPack("level.lvl"));
+
+        OBLEPack pack;
+        pack.setName("Bench pack");
+        for(const auto& s : shipped.getSectors())
+            shipped.forLevels(s.second, [&pack, &s, mCopies](
+                                            int mKey, const OBLELevel& mL)
+                {
+                    auto& levels(pack.getSector(s.first).getLevels());
+                    for(auto i(0); i < mCopies; ++i)
+                        levels[mKey + i * 100000] = mL;
+                });
+
+        OBLEBinary::savePack(pack, mPath);
+        return getFileBytes(mPath);
+    }
+
+    // Times `mLoad(mPath)` and reports it with its peak heap growth
+    template <typename TF>
+    inline void runPackLoad(const std::string& mName, const std::string& mPath,
+        SizeT mFileBytes, const TF& mLoad)
+    {
+        double ms;
+        auto peak(getPeakBytes([&ms, &mPath, &mLoad]
+            {
+                ms = getMs([&mPath, &mLoad]
+                    {
+                        mLoad(mPath);
+                    });
+            }));
+        reportPack(mName, ms, peak, mFileBytes);
+    }
+
+    // Streaming vs DOM loading of a large JSON pack - the DOM holds the
+    // whole file and its converted copy next to the levels, the stream
+    // reader one batch of levels' tiles
+    void benchJsonRead()
+    {
+        const std::string path{"OBBench.json.tmp"};
+        auto fileBytes(writeLargePack(path, 40));
+        std::cout << "Loading a " << fileBytes / 1024 << " KB JSON pack"
+                  << std::endl;
+
+        auto run([&path, fileBytes](const std::string& mName, auto mLoad)
+            {
+                runPackLoad(mName, path, fileBytes, mLoad);
+            });
+
+        run("DOM", [](const std::string& mPath)
+            {
+                loadPackDom(mPath);
+            });
+        run("stream, 1 thread", [](const std::string& mPath)
+            {
+                OBWorkers serial{1};
+                OBLEJsonReader::readFromFile(mPath, serial);
+            });
+        run("stream, all threads", [](const std::string& mPath)
+            {
+                OBWorkers workers{
+                    std::max(1u, std::thread::hardware_concurrency())};
+                OBLEJsonReader::readFromFile(mPath, workers);
+            });
+
+        std::remove(path.c_str());
+    }
+
+    // Size and full read time of the shipped pack, saved in each format -
+    // binary packs elide default params and run-length encode their tiles
+    void benchPackFormats()
+    {
+        auto shipped(OBLEBinary::loadPack("level.lvl"));
+        std::cout << "Saving the shipped pack ("
+                  << getFileBytes("level.lvl") / 1024 << " KB as shipped)"
+                  << std::endl;
+
+        for(const std::string& path : {"OBBench.tmp.obp", "OBBench.tmp.json"})
+        {
+            OBLEBinary::savePack(shipped, path);
+            auto fileBytes(getFileBytes(path));
+            std::cout << "    " << path << ": " << fileBytes / 1024.0 << " KB"
+                      << std::endl;
+
+            runPackLoad("read", path, fileBytes,
+                [](const std::string& mPath)
+                {
+                    OBWorkers serial{1};
+                    OBLEBinary::readPack(mPath, serial);
+                });
+
+            std::remove(path.c_str());
+        }
+    }
+
+    // Building every level of a large binary pack, serially and on every
+    // thread
+    void benchPackBuild()
+    {
+        const std::string path{"OBBench.tmp.obp"};
+        auto fileBytes(writeLargePack(path, 40));
+        std::cout << "Reading every level of a " << fileBytes / 1024
+                  << " KB binary pack" << std::endl;
+
+        runPackLoad("1 thread", path, fileBytes, [](const std::string& mPath)
+            {
+                OBWorkers serial{1};
+                OBLEBinary::readFromFile(mPath, serial);
+            });
+        runPackLoad("all threads", path, fileBytes,
+            [](const std::string& mPath)
+            {
+                OBWorkers workers{
+                    std::max(1u, std::thread::hardware_concurrency())};
+                OBLEBinary::readFromFile(mPath, workers);
+            });
+
+        std::remove(path.c_str());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::pair<std::string, void (*)()>> benches{
+        {"dispatch", benchDispatch}, {"boids", benchBoids},
+        {"jsonRead", benchJsonRead}, {"packFormats", benchPackFormats},
+        {"packBuild", benchPackBuild}};
+
+    for(const auto& b : benches)
+    {
+        bool selected{argc == 1};
+        for(int i{1}; i < argc; ++i) selected |= b.first == argv[i];
+        if(selected) b.second();
+    }
+
+    return 0;
+}
@@ -0,0 +1,670 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Headless tests - runs every test, or only the ones named on the command
+// line, and fails if any check failed
+//
+// Covers the worker pool, the AI scheduler, pack reading and writing,
+// baking and behavior compilation - `ctest` runs it from `_RELEASE`, so
+// the shipped packs and behaviors can be checked too
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include "SSVBloodshed/OBCommon.hpp"
+#include "SSVBloodshed/OBWorkers.hpp"
+#include "SSVBloodshed/OBGAIScheduler.hpp"
+#include "SSVBloodshed/Behaviors/OBBCompiler.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBinary.hpp"
+#include "SSVBloodshed/LevelEditor/OBLEBake.hpp"
+
+using namespace ob;
+
+namespace
+{
+    int failures{0};
+
+    inline void check(bool mOk, const std::string& mWhat)
+    {
+        if(mOk) return;
+        ++failures;
+        std::cout << "    FAILED: " << mWhat << std::endl;
+    }
+
+    // A range that throws must not leave the pool waiting or unusable
+    void testWorkerExceptions()
+    {
+        OBWorkers workers{4};
+        constexpr SizeT size{1000};
+
+        bool thrown{false};
+        try
+        {
+            workers.forRanges(size, [](SizeT mBegin, SizeT mEnd)
+                {
+                    if(mBegin <= 500 && 500 < mEnd)
+                        throw std::runtime_error{"range"};
+                });
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        check(thrown, "a throwing range is rethrown by forRanges");
+
+        std::vector<int> visited(size, 0);
+        workers.forRanges(size, [&visited](SizeT mBegin, SizeT mEnd)
+            {
+                for(auto i(mBegin); i < mEnd; ++i) ++visited[i];
+            });
+
+        bool once{true};
+        for(auto v : visited) once &= v == 1;
+        check(once, "the pool runs every index once after a throw");
+    }
+
+    inline bool operator==(const OBGAIScheduler::Decision& mA,
+        const OBGAIScheduler::Decision& mB) noexcept
+    {
+        return mA.slot == mB.slot && mA.dist == mB.dist &&
+               mA.inSightRanged == mB.inSightRanged &&
+               mA.inSightMelee == mB.inSightMelee &&
+               mA.shooting == mB.shooting &&
+               mA.steeringVel == mB.steeringVel &&
+               mA.steeringMult == mB.steeringMult;
+    }
+
+    // Enemy decisions must not depend on the number of AI threads
+    void testAIDeterminism()
+    {
+        using Agent = OBGAIScheduler::Agent;
+        using Mind = OBGAIScheduler::Mind;
+
+        constexpr int agentCount{500}, frameCount{30};
+        constexpr int width{levelCols * toCoords(tileSize)},
+            height{levelRows * toCoords(tileSize)};
+
+        std::mt19937 rnd{1337};
+        auto getRndPos([&rnd]
+            {
+                return Vec2i{
+                    std::uniform_int_distribution<int>{0, width - 1}(rnd),
+                    std::uniform_int_distribution<int>{0, height - 1}(rnd)};
+            });
+        auto getRndF([&rnd](float mMin, float mMax)
+            {
+                return std::uniform_real_distribution<float>{mMin, mMax}(rnd);
+            });
+
+        OBGSightGrid sight;
+        OBGFlowField flow;
+        for(auto i(0); i < 120; ++i)
+        {
+            auto pos(getRndPos());
+            sight.addBlocker(pos);
+            flow.addBlocker(pos);
+        }
+        for(auto i(0); i < 10; ++i)
+            sight.addField(getRndPos(), getRndF(0.f, ssvu::tau), i % 2 == 0);
+
+        std::vector<OBGTargetRegistry::Slot> slots(3);
+        for(auto& s : slots)
+        {
+            s.cPhys = nullptr;
+            s.posI = getRndPos();
+            s.posF = Vec2f(s.posI);
+            s.vel = Vec2f{getRndF(-100.f, 100.f), getRndF(-100.f, 100.f)};
+            s.alive = true;
+        }
+        slots[2].alive = false;
+
+        OBGTargetRegistry targets;
+        targets.assign(slots);
+        flow.setTarget(slots[0].posI);
+        flow.refresh();
+
+        constexpr Mind minds[]{
+            Mind::None, Mind::Gunner, Mind::Slammer, Mind::Kiter};
+        std::vector<Agent> agents(agentCount);
+        for(auto i(0u); i < agents.size(); ++i)
+        {
+            auto& a(agents[i]);
+            a.posI = getRndPos();
+            a.pos = Vec2f(a.posI);
+            a.vel = ssvs::zeroVec2f;
+            a.currentDeg = getRndF(0.f, 360.f);
+            a.maxVel = getRndF(50.f, 400.f);
+            a.evadeDist = getRndF(8000.f, 11000.f);
+            a.mind = minds[i % 4];
+            a.armed = i % 3 != 0;
+        }
+
+        OBGAIScheduler::Senses senses{targets, sight, flow};
+        OBWorkers serial{1}, parallel{4};
+        std::vector<OBGAIScheduler::Decision> serialOut, parallelOut;
+
+        bool equal{true};
+        for(auto f(0); f < frameCount && equal; ++f)
+        {
+            for(auto i(0u); i < agents.size(); ++i)
+                agents[i].thinks = (i + f) % 3 == 0;
+
+            OBGAIScheduler::decide(agents, serialOut, senses, serial);
+            OBGAIScheduler::decide(agents, parallelOut, senses, parallel);
+
+            for(auto i(0u); i < agents.size(); ++i)
+                equal &= serialOut[i] == parallelOut[i];
+
+            // Moves the agents by their decisions, as the game would
+            for(auto i(0u); i < agents.size(); ++i)
+            {
+                auto& a(agents[i]);
+                const auto& d(serialOut[i]);
+                a.vel += (d.steeringVel - a.vel) * d.steeringMult;
+                a.pos += a.vel;
+                a.posI = Vec2i(a.pos);
+                a.currentDeg = ssvs::getDeg(a.vel);
+                a.last = d;
+            }
+        }
+
+        check(equal, "serial and parallel decisions are identical");
+    }
+
+    // Every level and tile of a pack, in a stable order - packs compare
+    // equal when their dumps do
+    struct PackDump
+    {
+        using Level = std::array<int, 7>; // Sector, key, x, y, cols, ...
+        using Tile = std::tuple<std::array<int, 6>, OBLEParams>;
+
+        std::string name;
+        std::vector<Level> levels;
+        std::vector<Tile> tiles;
+
+        inline bool operator==(const PackDump& mD) const
+        {
+            return name == mD.name && levels == mD.levels &&
+                   tiles == mD.tiles;
+        }
+    };
+
+    inline PackDump dumpPack(const OBLEPack& mPack)
+    {
+        PackDump result;
+        result.name = mPack.getName();
+
+        std::vector<int> sectorIdxs;
+        for(const auto& s : mPack.getSectors())
+            sectorIdxs.emplace_back(s.first);
+        ssvu::sort(sectorIdxs);
+
+        for(auto s : sectorIdxs)
+            mPack.forLevels(mPack.getSectors().at(s),
+                [&result, s](int mKey, const OBLELevel& mL)
+                {
+                    result.levels.push_back({{s, mKey, mL.getX(), mL.getY(),
+                        mL.getColumns(), mL.getRows(), mL.getDepth()}});
+                    mL.forTiles([&result, s, mKey](const OBLETile& mT)
+                        {
+                            result.tiles.emplace_back(
+                                std::array<int, 6>{{s, mKey, mT.getX(),
+                                    mT.getY(), mT.getZ(), int(mT.getType())}},
+                                mT.getParams());
+                        });
+                });
+
+        return result;
+    }
+
+    inline OBLEPack readJson(const std::string& mJson)
+    {
+        OBWorkers serial{1};
+        std::istringstream iss{mJson};
+        return OBLEJsonReader::read(iss, serial);
+    }
+
+    // ssvj writes empty lists as `null`, the editor's `level.txt` is full of
+    // them
+    void testJsonNullLists()
+    {
+        auto dump(dumpPack(readJson(
+            "[\"nulls\", [[0, [[1, [1, 0, 32, 22, 5, null]],"
+            "[2, [2, 0, 32, 22, 5, [[0, [0, 0, 0, 2, null]]]]]]]]]")));
+
+        check(dump.levels.size() == 2, "levels with a null tile list load");
+        check(dump.tiles.size() == 1, "tiles with a null param list load");
+    }
+
+    inline std::string getJsonError(const std::string& mJson)
+    {
+        try
+        {
+            readJson(mJson);
+        }
+        catch(const std::runtime_error& mEx)
+        {
+            return mEx.what();
+        }
+        return "";
+    }
+    inline bool hasStr(const std::string& mStr, const std::string& mPart)
+    {
+        return mStr.find(mPart) != std::string::npos;
+    }
+
+    // Broken packs are rejected with the position of the offending token
+    void testJsonErrors()
+    {
+        auto truncated(getJsonError("[\"t\", [[0, [[1, [1, 0, 32, 22"));
+        check(hasStr(truncated, "end of input"), "truncated pack");
+
+        auto cols(
+            getJsonError("[\"t\", [[0, [[1, [1, 0, -3, 22, 5, null]]]]]]"));
+        check(hasStr(cols, "line 1, column 24") && hasStr(cols, "columns"),
+            "negative column count and its position");
+
+        auto depth(
+            getJsonError("[\"t\", [[0, [[1, [1, 0, 32, 22, 500, null]]]]]]"));
+        check(hasStr(depth, "column 32") && hasStr(depth, "depth"),
+            "oversized depth and its position");
+
+        auto type(getJsonError("[\"t\", [[0, [[1, [1, 0, 32, 22, 5,\n"
+                               "[[0, [0, 0, 0, 99, null]]]]]]]]]"));
+        check(hasStr(type, "line 2, column 16 (byte 49)") &&
+                  hasStr(type, "tile type 99"),
+            "unknown tile type and its position");
+
+        auto number(
+            getJsonError("[\"t\", [[0, [[1, [1, 0, 32, 2..2, 5, null]]]]]]"));
+        check(hasStr(number, "column 28") && hasStr(number, "2..2"),
+            "corrupt number and its position");
+    }
+
+    void testShippedPacks()
+    {
+        for(const auto& path : {"level.lvl", "level.txt"})
+        {
+            try
+            {
+                OBWorkers workers{4};
+                auto dump(
+                    dumpPack(OBLEJsonReader::readFromFile(path, workers)));
+                check(dump.name == "Test Pack #1" && dump.levels.size() == 13 &&
+                          !dump.tiles.empty(),
+                    std::string{path} + " has its 13 levels");
+            }
+            catch(const std::exception& mError)
+            {
+                check(false, std::string{path} + ": " + mError.what());
+            }
+        }
+    }
+
+    // Saves `mPack` to `mPath`, in the format its extension picks, and
+    // dumps the pack loaded back from it
+    inline PackDump getRoundTrip(
+        const OBLEPack& mPack, const std::string& mPath)
+    {
+        PackDump result;
+        {
+            OBLEBinary::savePack(mPack, mPath);
+            result = dumpPack(OBLEBinary::loadPack(mPath));
+        }
+        std::remove(mPath.c_str());
+        return result;
+    }
+
+    // Levels without tiles must keep their keys, or the game can't enter
+    // them - 10 of the shipped pack's 13 levels have none
+    void testBlankLevels()
+    {
+        auto pack(OBLEBinary::loadPack("level.lvl"));
+        auto dump(dumpPack(pack));
+
+        for(const auto& path : {"OBTests.tmp.obp", "OBTests.tmp.json"})
+        {
+            auto loaded(getRoundTrip(pack, path));
+            check(loaded.levels.size() == 13,
+                std::string{path} + " keeps the blank levels");
+            check(loaded == dump, std::string{path} + " round-trips");
+        }
+    }
+
+    // Converting to binary and back to JSON, or the other way around, must
+    // give back the same levels
+    void testConvert()
+    {
+        const std::string binPath{"OBTests.tmp.obp"},
+            jsonPath{"OBTests.tmp.json"}, binPath2{"OBTests.tmp2.obp"};
+
+        auto dump(dumpPack(OBLEBinary::loadPack("level.txt")));
+
+        OBLEBinary::convert("level.txt", binPath);
+        OBLEBinary::convert(binPath, jsonPath);
+        OBLEBinary::convert(jsonPath, binPath2);
+
+        check(dumpPack(OBLEBinary::loadPack(binPath)) == dump,
+            "JSON -> binary keeps every level");
+        check(dumpPack(OBLEBinary::loadPack(jsonPath)) == dump,
+            "JSON -> binary -> JSON keeps every level");
+        check(dumpPack(OBLEBinary::loadPack(binPath2)) == dump,
+            "binary -> JSON -> binary keeps every level");
+
+        for(const auto& path : {binPath, jsonPath, binPath2})
+            std::remove(path.c_str());
+    }
+
+    // Overwrites a field of the first record of a binary pack's section
+    // with `mValue`, and reads the pack back
+    inline bool readCorruptThrows(OBLEBin::u32 OBLEBin::Header::*mSection,
+        SizeT mField, OBLEBin::i32 mValue)
+    {
+        auto bytes(OBLEBinary::write(
+            readJson("[\"b\", [[0, [[1, [0, 0, 32, 22, 5,"
+                     "[[0, [0, 0, 0, 2, null]]]]]]]]]")));
+
+        OBLEBin::Header h;
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        std::memcpy(bytes.data() + h.*mSection + mField, &mValue,
+            sizeof(mValue));
+
+        try
+        {
+            OBLEBinary::read({bytes.data(), bytes.size()});
+        }
+        catch(const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // Corrupt records are rejected before they size or index anything
+    void testBinaryErrors()
+    {
+        using namespace OBLEBin;
+        const auto levels(&Header::levelsOffset), tiles(&Header::tilesOffset);
+
+        check(!readCorruptThrows(levels, offsetof(LevelRec, cols), 32),
+            "an intact pack reads");
+        check(readCorruptThrows(levels, offsetof(LevelRec, cols), -1),
+            "negative level columns");
+        check(readCorruptThrows(levels, offsetof(LevelRec, depth), 1 << 30),
+            "overflowing level depth");
+        check(readCorruptThrows(tiles, offsetof(TileRec, type), 99),
+            "unknown tile type");
+    }
+
+    // Level `mIdx` of a generated pack - a single wall, placed by index
+    inline OBLELevel getGeneratedLevel(int mSectorCols, SizeT mIdx)
+    {
+        auto idx(int(mIdx));
+        OBLELevel result{idx % mSectorCols, idx / mSectorCols, levelCols,
+            levelRows, 5};
+        result.set({{}, OBLETType::LETWall, idx % levelCols,
+            idx / levelCols % levelRows, 0});
+        return result;
+    }
+
+    inline std::vector<std::array<int, 4>> getTiles(const OBLELevel& mLevel)
+    {
+        std::vector<std::array<int, 4>> result;
+        mLevel.forTiles([&result](const OBLETile& mT)
+            {
+                result.push_back(
+                    {{mT.getX(), mT.getY(), mT.getZ(), int(mT.getType())}});
+            });
+        return result;
+    }
+
+    // A generated 100x100 sector, saved in both formats: opening it reads
+    // only the index, levels are read on first access, and cold ones are
+    // evicted under the cap
+    void testLazyPack()
+    {
+        constexpr int side{100};
+
+        for(const auto& path : {"OBTests.tmp.obp", "OBTests.tmp.json"})
+        {
+            {
+                // Generated levels are only ever built one at a time, as
+                // the writer visits them
+                OBLEPack pack;
+                pack.setName("Generated");
+                pack.setLoader([](SizeT mIdx)
+                    {
+                        return getGeneratedLevel(side, mIdx);
+                    });
+
+                auto& sector(pack.getSector(0));
+                sector = OBLESector{side, side};
+                for(auto i(0); i < side * side; ++i) sector.addStored(i, i);
+
+                OBLEBinary::savePack(pack, path);
+            }
+
+            {
+                auto pack(OBLEBinary::loadPack(path));
+                check(pack.getResidentCount() == 0,
+                    std::string{path} + ": opening reads no level");
+                check(pack.getSectors().at(0).getLevelKeys().size() ==
+                          SizeT(side * side),
+                    std::string{path} + ": opening indexes every level");
+
+                auto idx(37 + 58 * side);
+                check(getTiles(pack.getLevel(0, 37, 58)) ==
+                          getTiles(getGeneratedLevel(side, idx)),
+                    std::string{path} + ": a level is read back as written");
+
+                auto cap(getGeneratedLevel(side, 0).getMemorySize() * 8);
+                pack.setMemoryCap(cap);
+                for(auto i(0); i < side * side; i += 7)
+                    pack.getLevel(0, i % side, i / side);
+
+                check(pack.getResidentCount() == 8 &&
+                          pack.getResidentBytes() <= cap,
+                    std::string{path} +
+                        ": resident levels stay under the memory cap");
+            }
+
+            std::remove(path);
+        }
+    }
+
+    // Levels are built on the workers in batches, and must come out the
+    // same as a serial load - checked on copies of the shipped levels,
+    // enough for several batches
+    void testParallelLoad()
+    {
+        auto shipped(OBLEBinary::loadPack("level.txt"));
+
+        OBLEPack pack;
+        pack.setName(shipped.getName());
+        for(const auto& s : shipped.getSectors())
+            shipped.forLevels(s.second, [&pack, &s](
+                                            int mKey, const OBLELevel& mL)
+                {
+                    auto& levels(pack.getSector(s.first).getLevels());
+                    for(auto i(0); i < 8; ++i) levels[mKey + i * 1000] = mL;
+                });
+
+        for(const auto& path : {"OBTests.tmp.json", "OBTests.tmp.obp"})
+        {
+            OBLEBinary::savePack(pack, path);
+
+            OBWorkers serial{1}, parallel{4};
+            auto isBinary(OBLEBinary::isBinaryPath(path));
+            auto load([&path, isBinary](OBWorkers& mWorkers)
+                {
+                    // Binary packs are read whole here, not lazily
+                    return dumpPack(isBinary
+                                        ? OBLEBinary::readFromFile(
+                                              path, mWorkers)
+                                        : OBLEJsonReader::readFromFile(
+                                              path, mWorkers));
+                });
+
+            auto serialDump(load(serial));
+            check(serialDump.levels.size() == 13 * 8 &&
+                      serialDump == load(parallel),
+                std::string{path} + " loads the same on 1 and 4 threads");
+
+            std::remove(path);
+        }
+    }
+
+    // Plates stacked on different layers are clustered separately, each
+    // with the plates next to it on its own layer
+    void testPlateLayers()
+    {
+        OBLELevel level{0, 0, levelCols, levelRows, 5};
+        for(auto z : {0, 1})
+            for(auto x : {3, 4})
+                level.set({{}, OBLETType::LETPPlateSingle, x, 4, z});
+
+        auto baked(bakeLevel(level));
+
+        bool clustered{true};
+        for(const auto& s : baked.spawns)
+            clustered &= s.cluster != -1 &&
+                         baked.plateClusters[s.cluster].size() == 2;
+        check(baked.plateClusters.size() == 2 && clustered,
+            "stacked plates are clustered per layer");
+    }
+
+    // Baked levels remember the hash of their source, so edited levels are
+    // detected - and corrupt enum params are rejected when read
+    void testBakedPacks()
+    {
+        const std::string path{"OBTests.tmp.baked"};
+
+        OBLEPack pack;
+        auto& level(pack.getSector(0).getLevels()[1]);
+        level = OBLELevel{0, 0, levelCols, levelRows, 5};
+        level.set({{{"enemyType", ssvj::IntS(2)}}, OBLETType::LETSpawner, 1,
+            1, 0});
+        level.set({{}, OBLETType::LETWall, 2, 1, 0});
+
+        OBLEBakedPack::bake(pack).writeToFile(path);
+        auto read(OBLEBakedPack::readFromFile(path));
+        check(read.find(0, 1) != nullptr &&
+                  read.find(0, 1)->sourceHash == getLevelHash(level),
+            "baked levels keep their source's hash");
+
+        auto edited(level);
+        edited.set({{}, OBLETType::LETWall, 3, 1, 0});
+        check(getLevelHash(edited) != getLevelHash(level),
+            "edited levels hash differently");
+
+        // The spawner is the first spawn, and `OBLEParams` starts with one
+        // 4 byte slot per key
+        auto offset(4 * sizeof(std::uint32_t) + 2 * sizeof(std::int32_t) +
+                    sizeof(std::uint64_t) + sizeof(std::uint32_t) +
+                    SizeT(OBLEPKey::EnemyType) * sizeof(std::int32_t));
+        {
+            std::fstream fs{path, std::ios::in | std::ios::out |
+                                      std::ios::binary};
+            std::int32_t enemyType{99};
+            fs.seekp(offset);
+            fs.write(reinterpret_cast<const char*>(&enemyType),
+                sizeof(enemyType));
+        }
+
+        bool threw{false};
+        try
+        {
+            OBLEBakedPack::readFromFile(path);
+        }
+        catch(const std::runtime_error&)
+        {
+            threw = true;
+        }
+        check(threw, "out of range enum params are rejected");
+
+        std::remove(path.c_str());
+    }
+
+    inline bool compileThrows(const std::string& mTracks)
+    {
+        try
+        {
+            getBehaviorFromJson(ssvj::fromStr(
+                "{\"weapons\": [\"plasmaCannon\"], \"sounds\": [], "
+                "\"tracks\": " +
+                mTracks + "}"));
+        }
+        catch(const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // Shipped behaviors compile, broken ones are rejected when compiled
+    // instead of misbehaving when run
+    void testBehaviorErrors()
+    {
+        for(const auto& name : {"charger", "juggernaut", "giant", "enforcer"})
+        {
+            OBBehavior b;
+            try
+            {
+                b = getBehaviorFromJson(ssvj::fromFile(
+                    std::string{"Data/Behaviors/"} + name + ".json"));
+            }
+            catch(const std::runtime_error& mEx)
+            {
+                std::cout << "    " << mEx.what() << std::endl;
+            }
+            check(!b.code.empty(), std::string{name} + " compiles");
+        }
+
+        check(!compileThrows("[[[\"shoot\", 0, 10]]]"), "valid track");
+        check(compileThrows("[[[\"shoot\", 1, 10]]]"), "weapon index");
+        check(compileThrows("[[[\"sound\", 0]]]"), "sound index");
+        check(compileThrows("[[[\"wait\", \"x\"]]]"), "non-numeric arg");
+        check(compileThrows("[[[\"fly\"]]]"), "unknown statement");
+        check(compileThrows("[[[\"if\", [\"near\"], []]]]"),
+            "unknown condition");
+        check(compileThrows("[[[\"if\", [\"not\"], []]]]"),
+            "not without a condition");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::pair<std::string, void (*)()>> tests{
+        {"workerExceptions", testWorkerExceptions},
+        {"aiDeterminism", testAIDeterminism},
+        {"jsonNullLists", testJsonNullLists},
+        {"jsonErrors", testJsonErrors},
+        {"shippedPacks", testShippedPacks},
+        {"blankLevels", testBlankLevels}, {"convert", testConvert},
+        {"binaryErrors", testBinaryErrors},
+        {"lazyPack", testLazyPack}, {"parallelLoad", testParallelLoad},
+        {"plateLayers", testPlateLayers}, {"bakedPacks", testBakedPacks},
+        {"behaviorErrors", testBehaviorErrors}};
+
+    for(const auto& t : tests)
+    {
+        bool selected{argc == 1};
+        for(int i{1}; i < argc; ++i) selected |= t.first == argv[i];
+        if(!selected) continue;
+
+        std::cout << t.first << std::endl;
+        t.second();
+    }
+
+    std::cout << (failures == 0 ? "All checks passed" : "Some checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}